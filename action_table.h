@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * SPLIT UNO - ACTION CARD TABLE
+ *
+ * Maps a typed action card token (BLOCK, +2, ...) straight to an
+ * ActionType, which the arbiter uses to index its handler table. Tokens are
+ * looked up in a compile-time perfect hash: one hash, one slot load, one
+ * short case-insensitive compare.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_ACTION_TABLE_H
+#define SPLIT_UNO_ACTION_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Card types in Split UNO
+enum class ActionType : uint8_t {
+    BLOCK,
+    SKIP,
+    REVERSE,
+    COLOR_CHANGE,
+    WILD,
+    DRAW_TWO,
+    DRAW_FOUR,
+    TRUTH,
+    DARE,
+    UNKNOWN
+};
+
+constexpr int NUM_ACTION_TYPES = static_cast<int>(ActionType::UNKNOWN);
+
+struct ActionToken {
+    const char* text;
+    uint8_t length;
+    ActionType type;
+};
+
+constexpr ActionToken ACTION_TOKENS[] = {
+    {"BLOCK",   5, ActionType::BLOCK},
+    {"SKIP",    4, ActionType::SKIP},
+    {"REVERSE", 7, ActionType::REVERSE},
+    {"COLOR",   5, ActionType::COLOR_CHANGE},
+    {"WILD",    4, ActionType::WILD},
+    {"+2",      2, ActionType::DRAW_TWO},
+    {"+4",      2, ActionType::DRAW_FOUR},
+    {"TRUTH",   5, ActionType::TRUTH},
+    {"DARE",    4, ActionType::DARE},
+};
+
+constexpr int NUM_ACTION_TOKENS = sizeof(ACTION_TOKENS) / sizeof(ACTION_TOKENS[0]);
+constexpr unsigned ACTION_HASH_SIZE = 32;  // Power of two, masked below
+
+constexpr unsigned char upperAscii(unsigned char c) {
+    return static_cast<unsigned char>(c - ((c >= 'a' && c <= 'z') ? 32 : 0));
+}
+
+// First byte, last byte and length are enough to separate every token.
+constexpr unsigned actionHash(const char* s, size_t n) {
+    return (upperAscii(static_cast<unsigned char>(s[0])) * 2u +
+            upperAscii(static_cast<unsigned char>(s[n - 1])) + static_cast<unsigned>(n)) &
+           (ACTION_HASH_SIZE - 1);
+}
+
+// Slot -> index into ACTION_TOKENS, or -1 for an empty slot.
+constexpr std::array<int8_t, ACTION_HASH_SIZE> buildActionSlots() {
+    std::array<int8_t, ACTION_HASH_SIZE> slots{};
+    for (auto& slot : slots) slot = -1;
+    for (int i = 0; i < NUM_ACTION_TOKENS; ++i) {
+        slots[actionHash(ACTION_TOKENS[i].text, ACTION_TOKENS[i].length)] = static_cast<int8_t>(i);
+    }
+    return slots;
+}
+
+constexpr std::array<int8_t, ACTION_HASH_SIZE> ACTION_SLOTS = buildActionSlots();
+
+constexpr bool actionHashIsPerfect() {
+    int used = 0;
+    for (auto slot : ACTION_SLOTS) used += slot >= 0;
+    return used == NUM_ACTION_TOKENS;
+}
+
+static_assert(actionHashIsPerfect(), "action token hash has collisions; adjust actionHash");
+
+// Terminal protocol: case-insensitive token lookup.
+inline ActionType lookupAction(const char* s, size_t n) {
+    if (n == 0) return ActionType::UNKNOWN;
+    int idx = ACTION_SLOTS[actionHash(s, n)];
+    if (idx < 0) return ActionType::UNKNOWN;
+    const ActionToken& token = ACTION_TOKENS[idx];
+    if (token.length != n) return ActionType::UNKNOWN;
+    for (size_t i = 0; i < n; ++i) {
+        if (upperAscii(static_cast<unsigned char>(s[i])) != static_cast<unsigned char>(token.text[i])) {
+            return ActionType::UNKNOWN;
+        }
+    }
+    return token.type;
+}
+
+#endif // SPLIT_UNO_ACTION_TABLE_H
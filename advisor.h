@@ -0,0 +1,371 @@
+/*******************************************************************************
+ * SPLIT UNO - ADVISOR
+ *
+ * Expectimax search over the count-based state of a 2-player game that
+ * recommends an option at the arbiter's decision prompts: countering a
+ * +2/+4 or a BLOCK, picking the TRUTH penalty or the streak bonus, and
+ * challenging a player at 0 cards.
+ *
+ * The option itself is applied by the real rule engine. After it the
+ * search looks ahead over number rounds: each round is a chance node over
+ * both bids (resolved through round_table.h, with equal outcomes merged),
+ * whose steals and draws are clamped by the hands and by
+ * numberDeckRemaining / actionDeckRemaining; streak bonuses and challenges
+ * are decision nodes for the player concerned, played out by the engine's
+ * own handlers. Future action cards are not
+ * modelled since the arbiter cannot know who holds which.
+ *
+ * Search runs by iterative deepening (one more number round per pass) until
+ * the latency budget runs out, and answers from the deepest finished pass.
+ * ponder() runs the same passes without a budget until a flag is raised,
+ * reporting every finished pass. Chance nodes are memoized in a fixed-size
+ * table keyed by state and depth, which stays valid across prompts until
+ * the bid odds change.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_ADVISOR_H
+#define SPLIT_UNO_ADVISOR_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "bots.h"
+#include "engine.h"
+#include "evaluator.h"
+#include "game_state.h"
+#include "round_table.h"
+#include "rules.h"
+
+// Prompts the advisor can answer, with their options:
+//   DRAW_COUNTER   0 = no counter, 2 = +2, 4 = +4       (decided by the target)
+//   BLOCK_COUNTER  0 = accept the block, 1 = counter   (decided by the target)
+//   TRUTH_PENALTY  1 = penalty A, 2 = penalty B        (decided by the attacker)
+//   BONUS_CHOICE   1 = draw action cards, 2 = opponent draws
+//   CHALLENGE      0 = no challenge, 2 = +2, 4 = +4    (decided by the challenger)
+enum class Decision : uint8_t {
+    DRAW_COUNTER,
+    BLOCK_COUNTER,
+    TRUTH_PENALTY,
+    BONUS_CHOICE,
+    CHALLENGE,
+};
+
+inline const char* describeOption(Decision d, int option) {
+    switch (d) {
+        case Decision::DRAW_COUNTER:
+        case Decision::CHALLENGE:
+            return option == 0 ? (d == Decision::CHALLENGE ? "no challenge" : "no counter")
+                               : (option == 2 ? "+2" : "+4");
+        case Decision::BLOCK_COUNTER: return option ? "counter" : "accept the block";
+        case Decision::TRUTH_PENALTY: return option == 1 ? "penalty A" : "penalty B";
+        case Decision::BONUS_CHOICE:  return option == 1 ? "draw action cards" : "opponent draws";
+    }
+    return "?";
+}
+
+struct AdvisorSettings {
+    uint32_t budgetMs = 50;   // Latency budget per prompt
+    int maxDepth = 24;        // Number rounds to look ahead at most
+    int tableBits = 18;       // Memo table holds 2^tableBits entries
+};
+
+struct Advice {
+    static constexpr int MAX_OPTIONS = 3;
+    int count = 0;
+    std::array<int, MAX_OPTIONS> option{};
+    std::array<float, MAX_OPTIONS> value{};  // Expected score for the decider: -1 loss .. +1 win
+    int best = 0;                            // Index of the recommended option
+    int depth = 0;                           // Number rounds searched ahead
+    uint64_t nodes = 0;
+};
+
+/*******************************************************************************
+ * SEARCH
+ ******************************************************************************/
+
+template <typename Rules>
+class Advisor {
+public:
+    explicit Advisor(const RuleTables& rules, const AdvisorSettings& config = {})
+        : tables(rules), settings(config), outcomes(RoundOutcomeTable::build(rules)),
+          memo(size_t(1) << config.tableBits) {
+        std::array<float, NUM_CARD_VALUES> uniform;
+        uniform.fill(1.0f / NUM_CARD_VALUES);
+        bidOdds = {uniform, uniform};
+        buildChance();
+    }
+
+    static constexpr bool supports(int numPlayers) { return numPlayers == 2; }
+
+    // Bid distribution assumed for a seat (uniform by default); weights
+    // need not be normalised. The memo table is only dropped when the
+    // odds actually change.
+    void setBidOdds(int seat, const std::array<float, NUM_CARD_VALUES>& odds) {
+        float total = 0.0f;
+        for (float p : odds) total += p;
+        std::array<float, NUM_CARD_VALUES> normalised;
+        for (int c = 0; c < NUM_CARD_VALUES; ++c) {
+            normalised[c] = total > 0.0f ? odds[c] / total : 1.0f / NUM_CARD_VALUES;
+        }
+        if (normalised == bidOdds[seat]) return;
+        bidOdds[seat] = normalised;
+        buildChance();
+        std::fill(memo.begin(), memo.end(), MemoEntry{});
+    }
+
+    // Ranks the options of one prompt for decider. amount is the +2/+4 being
+    // countered for DRAW_COUNTER and is ignored otherwise.
+    Advice advise(const GameState& s, Decision d, int decider, int amount = 0) {
+        Advice result;
+        search(s, d, decider, amount, Clock::now() + std::chrono::milliseconds(settings.budgetMs), nullptr,
+               [&](const Advice& a) { result = a; });
+        return result;
+    }
+
+    // Deepens without a time limit until stop is raised or maxDepth is
+    // reached, calling onPass(advice) with the static ranking and again
+    // after every finished pass.
+    template <typename OnPass>
+    void ponder(const GameState& s, Decision d, int decider, int amount, const std::atomic<bool>& stopFlag,
+                OnPass onPass) {
+        search(s, d, decider, amount, Clock::time_point::max(), &stopFlag, onPass);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    template <typename OnPass>
+    void search(const GameState& s, Decision d, int decider, int amount, Clock::time_point until,
+                const std::atomic<bool>* stopFlag, OnPass onPass) {
+        Advice advice;
+        me = decider;
+        int other = 1 - decider;
+        std::array<GameState, Advice::MAX_OPTIONS> after;
+
+        // Apply each option once through the rule engine
+        auto add = [&](int option, const GameState& state) {
+            advice.option[advice.count] = option;
+            after[advice.count++] = state;
+        };
+        switch (d) {
+            case Decision::DRAW_COUNTER:
+                for (int counter : {0, 2, 4}) {
+                    if (counter && !Rules::COUNTERS_ENABLED) break;
+                    add(counter, play(s, [amount](Engine& e, int p) { e.handleDrawCard(p, amount); },
+                                      other, decider, false, 1, counter));
+                }
+                break;
+            case Decision::BLOCK_COUNTER:
+                for (int yes : {0, 1}) {
+                    add(yes, play(s, [](Engine& e, int p) { e.handleBlockCard(p); }, other, decider, yes, 1, 0));
+                }
+                break;
+            case Decision::TRUTH_PENALTY:
+                for (int pick : {1, 2}) {
+                    add(pick, play(s, [](Engine& e, int p) { e.handleTruthCard(p); }, decider, other, false, pick, 0));
+                }
+                break;
+            case Decision::BONUS_CHOICE:
+                for (int pick : {1, 2}) add(pick, bonus(s, decider, pick));
+                break;
+            case Decision::CHALLENGE:
+                for (int card : {0, 2, 4}) add(card, challenge(s, other, decider, card));
+                break;
+        }
+
+        // Depth 0 is the static evaluation, so there is always an answer.
+        for (int i = 0; i < advice.count; ++i) advice.value[i] = leaf(after[i]);
+        nodes = 0;
+        aborted = false;
+        deadline = until;
+        stop = stopFlag;
+        for (int depth = 0; depth <= settings.maxDepth; ++depth) {
+            if (stop && stop->load(std::memory_order_relaxed)) break;
+            if (depth > 0) {
+                std::array<float, Advice::MAX_OPTIONS> values{};
+                for (int i = 0; i < advice.count && !aborted; ++i) values[i] = continueFrom(d, after[i], depth);
+                if (aborted) break;
+                advice.value = values;
+                advice.depth = depth;
+            }
+            advice.nodes = nodes;
+            advice.best = 0;
+            for (int i = 1; i < advice.count; ++i) {
+                if (advice.value[i] > advice.value[advice.best]) advice.best = i;
+            }
+            onPass(static_cast<const Advice&>(advice));
+        }
+        stop = nullptr;
+    }
+
+    // Replays one option through the engine handlers; counter doubles as
+    // the challenge card, with targetSeat challenging when it is non-zero.
+    struct ScriptedController : SilentController {
+        int targetSeat;
+        bool yes;
+        int pick;
+        int counter;
+
+        ScriptedController(int t, bool y, int p, int c) : targetSeat(t), yes(y), pick(p), counter(c) {}
+        int bid(const GameState&, int) { return 0; }
+        int target(const GameState&, int, Prompt) { return targetSeat; }
+        bool answer(const GameState&, int, Prompt) { return yes; }
+        int choice(const GameState&, int, Prompt) { return pick; }
+        int drawCounter(const GameState&, int, int) { return counter; }
+        int challenger(const GameState&, int) { return counter ? targetSeat : NO_CHALLENGE; }
+        int challengeCard(const GameState&, int, int) { return counter; }
+    };
+    using Engine = RuleEngine<Rules, ScriptedController>;
+
+    struct ChanceBranch {
+        RoundOutcome outcome;
+        float weight;
+    };
+
+    struct MemoEntry {
+        uint64_t key = 0;
+        float value = 0.0f;
+    };
+
+    const RuleTables tables;
+    const AdvisorSettings settings;
+    const RoundOutcomeTable outcomes;
+    EvalWeights weights;
+    std::array<std::array<float, NUM_CARD_VALUES>, 2> bidOdds;
+    std::array<std::vector<ChanceBranch>, 4> chance;  // Indexed by blocked[0] | blocked[1] << 1
+    std::vector<MemoEntry> memo;
+    ScriptedController script{0, false, 1, 0};
+    Engine engine{tables, script};  // Plays options, bonuses and challenges
+
+    int me = 0;  // Seat whose score the search maximises
+    uint64_t nodes = 0;
+    bool aborted = false;
+    Clock::time_point deadline;
+    const std::atomic<bool>* stop = nullptr;  // Raised by another thread to end ponder()
+
+    // Groups all bid pairs by identical outcome for each blocked combination.
+    void buildChance() {
+        for (int mask = 0; mask < 4; ++mask) {
+            std::vector<ChanceBranch>& branches = chance[mask];
+            branches.clear();
+            for (int a = 0; a < NUM_CARD_VALUES; ++a) {
+                for (int b = 0; b < NUM_CARD_VALUES; ++b) {
+                    bool blocked0 = mask & 1, blocked1 = mask & 2;
+                    if ((blocked0 && a > 0) || (blocked1 && b > 0)) continue;
+                    float w = (blocked0 ? 1.0f : bidOdds[0][a]) * (blocked1 ? 1.0f : bidOdds[1][b]);
+                    if (w <= 0.0f) continue;
+                    const RoundOutcome& o = outcomes(blocked0 ? NO_CARD : a, blocked1 ? NO_CARD : b);
+                    auto same = std::find_if(branches.begin(), branches.end(), [&](const ChanceBranch& c) {
+                        return std::memcmp(&c.outcome, &o, sizeof(o)) == 0;
+                    });
+                    if (same != branches.end()) {
+                        same->weight += w;
+                    } else {
+                        branches.push_back({o, w});
+                    }
+                }
+            }
+        }
+    }
+
+    float leaf(const GameState& s) const { return evaluateState(s, me, weights, tables.numberDeckAfterDeal(2)); }
+
+    // Value of the position right after a root option was applied
+    float continueFrom(Decision d, GameState s, int depth) {
+        if (d == Decision::BONUS_CHOICE) return afterRound(s, me + 1, depth);
+        if (d == Decision::CHALLENGE) return s.gameOver ? leaf(s) : winCheck(s, 2 - me, depth);
+        return roundValue(s, depth);
+    }
+
+    // Chance node: the next number round over all bid pairs
+    float roundValue(const GameState& s, int depth) {
+        if (s.gameOver || depth == 0) return leaf(s);
+        if ((++nodes & 1023) == 0 && (Clock::now() > deadline || (stop && stop->load(std::memory_order_relaxed)))) {
+            aborted = true;
+        }
+        if (aborted) return 0.0f;
+
+        uint64_t key = memoKey(s, depth);
+        MemoEntry& slot = memo[key & (memo.size() - 1)];
+        if (slot.key == key) return slot.value;
+
+        float value = 0.0f;
+        for (const ChanceBranch& c : chance[s.blocked[0] | (s.blocked[1] << 1)]) {
+            GameState next = s;
+            applyRoundOutcome(next, c.outcome);
+            value += c.weight * (c.outcome.resolved ? afterRound(next, 0, depth - 1) : roundValue(next, depth - 1));
+        }
+        if (!aborted) slot = {key, value};
+        return value;
+    }
+
+    // Streak bonuses from seat onwards, then the win check
+    float afterRound(GameState& s, int seat, int depth) {
+        for (int p = seat; p < 2; ++p) {
+            if (s.consecutiveWins[p] < tables.consecutiveWinsThreshold) continue;
+            float best = 0.0f;
+            for (int pick = 1; pick <= 2; ++pick) {
+                GameState next = bonus(s, p, pick);
+                float v = afterRound(next, p + 1, depth);
+                if (pick == 1 || (p == me ? v > best : v < best)) best = v;
+            }
+            return best;
+        }
+        return winCheck(s, 0, depth);
+    }
+
+    // Players at 0 cards from seat onwards; the opponent may challenge
+    float winCheck(GameState& s, int seat, int depth) {
+        for (int p = seat; p < 2; ++p) {
+            if (s.numberCards[p] != 0) continue;
+            int challenger = 1 - p;
+            float best = p == me ? 1.0f : -1.0f;  // Unchallenged: p wins
+            if (!Rules::CHALLENGES_ENABLED || s.actionCards[challenger] == 0) return best;
+            for (int card : {2, 4}) {
+                GameState next = challenge(s, p, challenger, card);
+                float v = winCheck(next, p + 1, depth);
+                best = challenger == me ? std::max(best, v) : std::min(best, v);
+            }
+            return best;
+        }
+        return roundValue(s, depth);
+    }
+
+    // s after handler(engine, actor) with the scripted answers
+    template <typename Handler>
+    GameState play(const GameState& s, Handler handler, int actor, int targetSeat, bool yes, int pick, int counter) {
+        script = ScriptedController(targetSeat, yes, pick, counter);
+        engine.restore(s, 0);
+        handler(engine, actor);
+        return engine.gameState();
+    }
+
+    GameState bonus(const GameState& s, int p, int pick) {
+        return play(s, [](Engine& e, int seat) { e.handleStreakBonus(seat); }, p, 1 - p, false, pick, 0);
+    }
+
+    // card 0 = no challenge, so winner wins
+    GameState challenge(const GameState& s, int winner, int challenger, int card) {
+        return play(s, [](Engine& e, int seat) { e.handleDrawChallenge(seat); }, winner, challenger, false, 1, card);
+    }
+
+    uint64_t memoKey(const GameState& s, int depth) const {
+        uint64_t h = static_cast<uint64_t>(depth) << 1 | static_cast<uint64_t>(me);
+        for (int i = 0; i < 2; ++i) {
+            h = splitMix64(h ^ static_cast<uint32_t>(s.numberCards[i]));
+            h = splitMix64(h ^ (static_cast<uint64_t>(s.actionCards[i]) << 8 |
+                                static_cast<uint64_t>(s.consecutiveWins[i]) << 40 |
+                                static_cast<uint64_t>(s.blocked[i]) << 56));
+        }
+        h = splitMix64(h ^ (static_cast<uint64_t>(s.numberDeckRemaining) << 20 |
+                            static_cast<uint64_t>(s.actionDeckRemaining)));
+        return h | 1;  // 0 marks an empty slot
+    }
+};
+
+#endif // SPLIT_UNO_ADVISOR_H
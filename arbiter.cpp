@@ -1,129 +1,159 @@
 /*******************************************************************************
  * SPLIT UNO - ARBITER APPLICATION
- * 
+ *
  * A game arbiter/tracker for Split UNO, a custom variant of the classic UNO
  * card game that separates number cards and action cards into distinct decks.
- * 
+ *
  * Author: Muktadir Somio
  * Version: 3.0 (Refactored for N Players)
  * Language: C++17
- * 
+ *
  * Description:
  *   This application helps arbitrate games of Split UNO by tracking:
  *   - Player card counts (number and action cards separately)
  *   - Game state (blocks, consecutive wins, deck remaining)
  *   - Win conditions and special card effects
- * 
+ *
  * Compilation:
- *   g++ arbiter.cpp -o app
- * 
+ *   g++ -std=c++17 -O2 -pthread arbiter.cpp -o app -ldl
+ *
  * Usage:
- *   ./app
+ *   ./app [--variant standard|speed|hardcore] [--rules FILE] [--record FILE]
+ *         [--save FILE] [--resume FILE] [--advise MS] [--hints] [--quiet]
+ *         [--turn-timeout S] [--timeout-bid CARD] [--timeout-counter pass|+2|+4]
+ *         [--timeout-block pass|block] [--timeout-challenge pass|+2|+4]
+ *   ./app --bench-eval
+ *   ./app --bench-lockstep [--variant standard|speed|hardcore] [--rules FILE]
+ *   ./app --bench-pool DIR [--variant standard|speed|hardcore] [--rules FILE]
+ *   ./app --sweep GRID [--games N] [--players N] [--threads N] [--seed N] [--bot random|greedy|numbers|PLUGIN]
+ *         [--events] [--precision W] [--record PATH]
+ *   ./app --tournament BOTS [--format swiss|round-robin] [--rounds N] [--games N] [--threads N] [--seed N]
+ *   ./app --model-check [--players N] [--cards N] [--depth N] [--threads N]
  ******************************************************************************/
 
 #include <iostream>
 #include <string>
 #include <vector>
+#include <array>
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iomanip>
 #include <limits>
 #include <map>
+#include <memory>
+
+#include "rules.h"
+#include "game_state.h"
+#include "action_table.h"
+#include "round_log.h"
+#include "round_table.h"
+#include "save_game.h"
+#include "history.h"
+#include "timer_wheel.h"
+#include "game_pool.h"
+#include "game_store.h"
+#include "bid_model.h"
+#include "evaluator.h"
+#include "advisor.h"
+#include "hint_engine.h"
+#include "engine.h"
+#include "console_output.h"
+#include "bot_plugin.h"
+#include "lockstep.h"
+#include "model_check.h"
+#include "sweep.h"
+#include "tournament.h"
 
 using namespace std;
 
 /*******************************************************************************
- * ENUMERATIONS & STRUCTS
+ * CONSOLE CONTROLLER
+ *
+ * Answers the rule engine's prompts from the operator at the terminal.
+ *
+ * With a turn timeout, each bid, counter decision and challenge window gets
+ * a deadline on a TimerWheel; a player who has not answered by then gets
+ * the default action and the game moves on. Only the decision itself is
+ * timed: once a counter or challenge is declared, the card is entered
+ * without a deadline.
  ******************************************************************************/
 
-// Card types in Split UNO
-enum class ActionType {
-    BLOCK,
-    SKIP,
-    REVERSE,
-    COLOR_CHANGE,
-    WILD,
-    DRAW_TWO,
-    DRAW_FOUR,
-    TRUTH,
-    DARE,
-    UNKNOWN
+// Per-decision time limit and what happens when it runs out
+struct TurnDeadlines {
+    uint32_t seconds = 0;  // 0 = wait as long as it takes
+    int bidCard = 0;            // Card played for a bid that times out
+    int counterCard = 0;        // +2/+4 counter played when that decision times out; 0 passes it on
+    bool blockCounter = false;  // Whether a BLOCK counter decision that times out counters
+    int challengeCard = 0;      // Card the seat after the winner challenges with at the deadline; 0 passes
 };
 
-// Card colors
-enum class Color {
-    RED, YELLOW, GREEN, BLUE, WILD
-};
+class ConsoleController {
+public:
+    static constexpr bool NARRATES = true;
 
-// Player Structure
-struct Player {
-    string name;
-    int numberCards;
-    int actionCards;
-    int consecutiveWins;
-    bool isBlocked;
-
-    Player(string n, int initialCards) 
-        : name(n), numberCards(initialCards), actionCards(0), 
-          consecutiveWins(0), isBlocked(false) {}
-};
+    ConsoleController(const RuleTables& rules, ostream& output, bool quietMode)
+        : out(output), quiet(quietMode), tables(rules), clockStart(chrono::steady_clock::now()) {}
 
-/*******************************************************************************
- * MAIN ARBITER CLASS
- ******************************************************************************/
+    ostream& out;                  // Buffered screen; flushed whenever input is read
+    const bool quiet;              // Machine-readable mode: no banners, menus or narration
+    vector<string> names;          // Player names by seat
+    TurnDeadlines deadlines;
+    bool inputClosed = false;      // Input hit end of file; every reader returns its placeholder
 
-class SplitUnoArbiter {
-private:
-    // Game Constants
-    static constexpr int INITIAL_CARDS = 20;              // Starting number cards per player
-    static constexpr int INITIAL_NUMBER_DECK = 68;        // Remaining number cards
-    static constexpr int INITIAL_ACTION_DECK = 32;        // Action cards available
-    static constexpr int CONSECUTIVE_WINS_THRESHOLD = 2;  // Wins needed for bonus
-    static constexpr int MAX_CARD_NUMBER = 9;             // Highest number card
-    static constexpr int MIN_CARD_NUMBER = 0;             // Lowest number card
-    static constexpr int CARD_0_DRAW = 1;                 // Cards stolen by playing 0
-    static constexpr int CARD_7_NUMBER_DRAW = 2;          // Number cards from card 7
-    static constexpr int CARD_7_ACTION_DRAW = 1;          // Action cards from card 7
-    
-    // Game State
-    vector<Player> players;        // List of players
-    int numberDeckRemaining;       // Remaining number cards in deck
-    int actionDeckRemaining;       // Remaining action cards in deck
-    bool gameOver;                 // Has the game ended?
-    string winner;                 // Game winner name
+    // Optional hooks around the decision prompts the advisor can rank:
+    // advise runs when one opens, decided once it is answered, and hint
+    // whenever the operator types "hint" (or "?") at any prompt.
+    function<void(const GameState&, Decision, int decider, int amount)> advise;
+    function<void()> decided;
+    function<void()> hint;
 
     /***************************************************************************
      * INPUT VALIDATION HELPERS
      ***************************************************************************/
-    
+
     void clearInputBuffer() {
         cin.clear();
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
     }
-    
+
+    // Past a deadline, the validated readers return at once with a
+    // placeholder that withDeadline replaces by the default action. They
+    // do the same once input is closed, and the game stops at the menu.
     int getValidatedInt(const string& prompt, int min, int max) {
         int value;
         while (true) {
-            cout << prompt;
+            if (!ask(prompt)) return min;
             if (cin >> value) {
                 if (value >= min && value <= max) {
                     clearInputBuffer();
                     return value;
                 } else {
-                    cout << ">>> Error: Please enter a number between " 
-                         << min << " and " << max << ".\n";
+                    say(">>> Error: Please enter a number between ", min, " and ", max, ".");
                 }
             } else {
-                cout << ">>> Error: Invalid input. Please enter a number.\n";
+                if (cin.eof()) return closeInput(min);
+                cin.clear();
+                string token;
+                if (cin >> token && hintRequested(token)) {
+                    clearInputBuffer();
+                    continue;
+                }
+                say(">>> Error: Invalid input. Please enter a number.");
                 clearInputBuffer();
             }
         }
     }
-    
+
     string getValidatedString(const string& prompt, const vector<string>& validOptions) {
         string input;
         while (true) {
-            cout << prompt;
+            if (!ask(prompt)) return validOptions.front();
             if (cin >> input) {
+                if (hintRequested(input)) {
+                    clearInputBuffer();
+                    continue;
+                }
                 input = toUpper(input);
                 for (const auto& option : validOptions) {
                     if (input == toUpper(option)) {
@@ -131,510 +161,1158 @@ private:
                         return input;
                     }
                 }
-                cout << ">>> Error: Invalid option. Please try again.\n";
+                say(">>> Error: Invalid option. Please try again.");
             } else {
-                cout << ">>> Error: Invalid input. Please try again.\n";
+                if (cin.eof()) return closeInput(validOptions.front());
+                say(">>> Error: Invalid input. Please try again.");
                 clearInputBuffer();
             }
         }
     }
-    
+
     string toUpper(string s) const {
         transform(s.begin(), s.end(), s.begin(), ::toupper);
         return s;
     }
 
+    // Shows a hint for "hint" or "?" when hints are on
+    bool hintRequested(const string& token) {
+        if (!hint || (token != "?" && toUpper(token) != "HINT")) return false;
+        hint();
+        return true;
+    }
+
+    // Reads the answer to a decision prompt between the advisor hooks
+    template <typename Read>
+    auto decide(const GameState& state, Decision d, int decider, int amount, Read read) {
+        if (advise) advise(state, d, decider, amount);
+        auto answer = read();
+        if (decided) decided();
+        return answer;
+    }
+
+    // Runs read under the turn deadline; if it passes first, says so and
+    // returns fallback instead of whatever read came back with.
+    template <typename T, typename Read>
+    T withDeadline(const string& expired, T fallback, Read read) {
+        if (deadlines.seconds == 0) return read();
+        TimerId timer = timers.schedule(elapsedMs() + uint64_t(deadlines.seconds) * 1000, 0);
+        T answer = read();
+        timers.cancel(timer);
+        if (!timedOut) return answer;
+        timedOut = false;
+        say("\n>>> Time is up: ", expired, ".");
+        return fallback;
+    }
+
+    // Shows prompt and waits until there is input to read; false once the
+    // open deadline has passed. Without a deadline on the wheel this returns
+    // at once and the read blocks as usual.
+    bool ask(const string& prompt) {
+        if (timedOut || inputClosed) return false;
+        out << prompt;
+        if (timers.size() == 0) return true;
+        out.flush();
+        while (cin.rdbuf()->in_avail() <= 0) {
+            uint64_t now = elapsedMs();
+            timers.advance(now, [this](uint64_t) { timedOut = true; });
+            if (timedOut) return false;
+            if (inputReady(POLL_MS)) break;
+        }
+        return true;
+    }
+
+    // Reads a whole line; an empty reply returns fallback
+    string getLine(const string& prompt, const string& fallback) {
+        string line;
+        out << prompt;
+        if (!getline(cin, line)) return closeInput(fallback);
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        return line.empty() ? fallback : line;
+    }
+
+    bool getYesNo(const string& prompt) {
+        string reply = getValidatedString(prompt, {"Y", "N", "YES", "NO"});
+        return !timedOut && !inputClosed && (reply == "Y" || reply == "YES");
+    }
+
     // Helper to get a player index by name or selection
     int getValidatedPlayerIndex(const string& prompt, int excludeIndex = -1) {
-        cout << prompt << endl;
-        for (size_t i = 0; i < players.size(); ++i) {
-            if (static_cast<int>(i) == excludeIndex) continue;
-            cout << "  (" << i + 1 << ") " << players[i].name << endl;
+        int numPlayers = static_cast<int>(names.size());
+        out << prompt << '\n';
+        for (int i = 0; i < numPlayers && !quiet; ++i) {
+            if (i == excludeIndex) continue;
+            out << "  (" << i + 1 << ") " << names[i] << '\n';
         }
-        
+
         while (true) {
-            int choice = getValidatedInt("Select Player: ", 1, players.size());
+            int choice = getValidatedInt("Select Player: ", 1, numPlayers);
             int index = choice - 1;
-            if (index == excludeIndex) {
-                cout << ">>> Error: You cannot select yourself/excluded player.\n";
+            if (index == excludeIndex && !timedOut && !inputClosed) {
+                say(">>> Error: You cannot select yourself/excluded player.");
             } else {
                 return index;
             }
         }
     }
 
-    ActionType parseActionType(const string& actionStr) {
-        if (actionStr == "BLOCK") return ActionType::BLOCK;
-        if (actionStr == "SKIP") return ActionType::SKIP;
-        if (actionStr == "REVERSE") return ActionType::REVERSE;
-        if (actionStr == "COLOR") return ActionType::COLOR_CHANGE;
-        if (actionStr == "WILD") return ActionType::WILD;
-        if (actionStr == "+2") return ActionType::DRAW_TWO;
-        if (actionStr == "+4") return ActionType::DRAW_FOUR;
-        if (actionStr == "TRUTH") return ActionType::TRUTH;
-        if (actionStr == "DARE") return ActionType::DARE;
-        return ActionType::UNKNOWN;
+    // Reads an action card token; isPlayable filters out actions this
+    // variant has no handler for.
+    template <typename IsPlayable>
+    ActionType getValidatedAction(const string& prompt, IsPlayable isPlayable) {
+        string input;
+        while (true) {
+            if (!ask(prompt)) return ActionType::UNKNOWN;
+            if (cin >> input) {
+                ActionType type = lookupAction(input.data(), input.size());
+                if (isPlayable(type)) {
+                    clearInputBuffer();
+                    return type;
+                }
+                say(">>> Error: Invalid option. Please try again.");
+            } else {
+                if (cin.eof()) return closeInput(ActionType::UNKNOWN);
+                say(">>> Error: Invalid input. Please try again.");
+                clearInputBuffer();
+            }
+        }
+    }
+
+    /***************************************************************************
+     * RULE ENGINE PROMPTS
+     ***************************************************************************/
+
+    int bid(const GameState&, int player) {
+        return withDeadline(names[player] + " plays " + to_string(deadlines.bidCard), deadlines.bidCard, [&] {
+            return getValidatedInt("Enter " + names[player] + "'s card (0-9): ", 0, NUM_CARD_VALUES - 1);
+        });
+    }
+
+    int target(const GameState&, int player, Prompt prompt) {
+        switch (prompt) {
+            case Prompt::STEAL_TARGET:   return getValidatedPlayerIndex("Who to steal from?", player);
+            case Prompt::PENALTY_TARGET: return getValidatedPlayerIndex("Who draws penalty?", player);
+            case Prompt::BLOCK_TARGET:   return getValidatedPlayerIndex("Who to BLOCK?", player);
+            case Prompt::SWAP_TARGET:    return getValidatedPlayerIndex("Who to swap hands with?", player);
+            case Prompt::DRAW_TARGET:    return getValidatedPlayerIndex("Who to attack?", player);
+            case Prompt::TRUTH_TARGET:   return getValidatedPlayerIndex("Who to ask?", player);
+            case Prompt::DARE_TARGET:    return getValidatedPlayerIndex("Who to dare?", player);
+            default:                     return getValidatedPlayerIndex("Select target:", player);
+        }
     }
-    
-    int drawFromNumberDeck(int amount) {
-        if (numberDeckRemaining <= 0) {
-            cout << ">>> WARNING: Number deck is exhausted! No cards drawn.\n";
-            return 0;
+
+    bool answer(const GameState& state, int player, Prompt prompt) {
+        switch (prompt) {
+            case Prompt::BLOCK_COUNTER:
+                return decide(state, Decision::BLOCK_COUNTER, player, 0, [&] {
+                    string expired = names[player] + (deadlines.blockCounter ? " counters with BLOCK" : " does not counter");
+                    return withDeadline(expired, deadlines.blockCounter, [&] {
+                        return getYesNo("Did " + names[player] + " play a BLOCK to counter? (Y/N): ");
+                    });
+                });
+            case Prompt::TRUTH_ANSWER:
+                return getYesNo("Did " + names[player] + " answer? (Y/N): ");
+            case Prompt::DARE_COMPLETE:
+                return getYesNo("Did " + names[player] + " complete the dare? (Y/N): ");
+            default:
+                return getYesNo("(Y/N): ");
         }
-        int actualDraw = min(amount, numberDeckRemaining);
-        numberDeckRemaining -= actualDraw;
-        return actualDraw;
     }
-    
-    int drawFromActionDeck(int amount) {
-        if (actionDeckRemaining <= 0) {
-            cout << ">>> WARNING: Action deck is exhausted! No cards drawn.\n";
-            return 0;
+
+    int choice(const GameState& state, int player, Prompt prompt) {
+        switch (prompt) {
+            case Prompt::BONUS_CHOICE:
+                return decide(state, Decision::BONUS_CHOICE, player, 0, [&] {
+                    return getValidatedInt(
+                        "Choose: (1) Draw " + to_string(tables.bonusActionDraw) + " Action Card(s) OR (2) All opponents draw " +
+                        to_string(tables.bonusOpponentDraw) + " Number Cards: ", 1, 2);
+                });
+            case Prompt::TRUTH_PENALTY:
+                return decide(state, Decision::TRUTH_PENALTY, player, 0, [&] {
+                    return getValidatedInt(
+                        "Penalty Choice:\n1. Attacker gets " + to_string(tables.truthAttackerAction[1]) +
+                        " Action, Target gets " + to_string(tables.truthTargetNumber[1]) + " Number\n2. Target gets " +
+                        to_string(tables.truthTargetNumber[2]) + " Number\nChoice: ", 1, 2);
+                });
+            case Prompt::COLOR_CHOICE: {
+                string color = getValidatedString(
+                    "Enter chosen color (R/Y/G/B): ",
+                    {"R", "Y", "G", "B", "RED", "YELLOW", "GREEN", "BLUE"}
+                );
+                if (color[0] == 'R') return static_cast<int>(Color::RED);
+                if (color[0] == 'Y') return static_cast<int>(Color::YELLOW);
+                if (color[0] == 'G') return static_cast<int>(Color::GREEN);
+                return static_cast<int>(Color::BLUE);
+            }
+            default:
+                return getValidatedInt("Choice: ", 1, 2);
         }
-        int actualDraw = min(amount, actionDeckRemaining);
-        actionDeckRemaining -= actualDraw;
-        return actualDraw;
     }
 
+    int drawCounter(const GameState& state, int targetIdx, int amount) {
+        return decide(state, Decision::DRAW_COUNTER, targetIdx, amount, [&] {
+            int fallback = deadlines.counterCard;
+            string expired = names[targetIdx] + (fallback ? " counters with +" + to_string(fallback) : " does not counter");
+            int declared = withDeadline(expired, fallback, [&] {
+                return getYesNo("Did " + names[targetIdx] + " counter with +2/+4? (Y/N): ") ? ANSWERED_YES : 0;
+            });
+            if (declared != ANSWERED_YES) return declared;
+            string oppCard = getValidatedString("Enter counter card (+2/+4): ", {"+2", "+4"});
+            return (oppCard == "+2") ? 2 : 4;
+        });
+    }
+
+    // The challenge card belongs to the same decision, so a challenge keeps
+    // the prompt open until challengeCard. At the deadline the window closes
+    // unchallenged, or the seat after the winner challenges with the
+    // configured card.
+    int challenger(const GameState& state, int winnerIdx) {
+        if (advise) advise(state, Decision::CHALLENGE, winnerIdx == 0 ? 1 : 0, 0);  // Two-player games only
+        int seat = (winnerIdx + 1) % static_cast<int>(names.size());
+        int fallback = deadlines.challengeCard;
+        string expired = fallback ? names[seat] + " challenges with +" + to_string(fallback) : "no challenge";
+        int declared = withDeadline(expired, fallback, [&] {
+            return getYesNo("Any challenges? (Y/N): ") ? ANSWERED_YES : 0;
+        });
+        int who = NO_CHALLENGE;
+        if (declared == ANSWERED_YES) {
+            who = getValidatedPlayerIndex("Who is challenging?", winnerIdx);
+        } else if (declared != 0) {
+            who = seat;
+            expiredChallenge = declared;
+        }
+        if (who == NO_CHALLENGE && decided) decided();
+        return who;
+    }
+
+    int challengeCard(const GameState&, int, int) {
+        if (expiredChallenge) {
+            if (decided) decided();
+            return exchange(expiredChallenge, 0);
+        }
+        string cardType = getValidatedString("Challenge card (+2/+4): ", {"+2", "+4"});
+        if (decided) decided();
+        return (cardType == "+2") ? 2 : 4;
+    }
+
+    const string& name(int player) const { return names[player]; }
+
+    // Narration and notices; quiet mode leaves only prompts and results
+    template <typename... Args>
+    void say(const Args&... args) {
+        if (!quiet) (out << ... << args) << '\n';
+    }
+
+private:
+    static constexpr int POLL_MS = 50;  // Longest wait for input between ticks
+    static constexpr int ANSWERED_YES = 1;  // A counter or challenge was declared; never a card
+
+    const RuleTables& tables;
+    chrono::steady_clock::time_point clockStart;
+    TimerWheel timers;             // Open decision deadlines, in ms since clockStart
+    bool timedOut = false;         // The open deadline fired before an answer
+    int expiredChallenge = 0;      // Card for a challenge made by the deadline, until challengeCard
+
+    // Marks input as closed and hands back the reader's placeholder
+    template <typename T>
+    T closeInput(T placeholder) {
+        inputClosed = true;
+        return placeholder;
+    }
+
+    uint64_t elapsedMs() const {
+        return static_cast<uint64_t>(
+            chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - clockStart).count());
+    }
+};
+
+/*******************************************************************************
+ * MAIN ARBITER CLASS
+ ******************************************************************************/
+
+template <typename Rules>
+class SplitUnoArbiter {
+private:
+    using Engine = RuleEngine<Rules, ConsoleController>;
+
+    // House rules, validated and flattened at startup
+    const RuleTables tables;
+
+    // Everything shown on screen; cin is tied to it, so each screen goes
+    // out in one write just before the program waits for input
+    mutable ConsoleOutput out;
+
+    // Operator prompts and the rule engine they drive
+    ConsoleController console;
+    Engine engine;
+    GameState& state;              // Card counts, decks, blocks and streaks (owned by engine)
+    vector<string>& names;         // Player names by seat (owned by console)
+
+    // Optional columnar export of every number round
+    string roundLogPath;
+    RoundLogWriter roundLog;
+
+    // Saved games: savePath is the default file and is rewritten after every
+    // round or action card when autosave is on
+    string savePath;
+    bool autosave;
+    bool resumed = false;
+
+    // Undo/redo over whole menu steps
+    StateHistory history;
+
+    // What-if branches: each is its own engine over a copy of the state.
+    // GameState is a small fixed-size value and the names stay with the
+    // shared console, so forking is a constant-time copy.
+    struct Branch {
+        string label;
+        Engine engine;
+    };
+    vector<unique_ptr<Branch>> branches;
+    int nextBranchId = 1;
+
+    // Expectimax advisor for 2-player games (null when disabled)
+    unique_ptr<Advisor<Rules>> advisor;
+
+    // Background search that answers "hint" at decision prompts (null when disabled)
+    unique_ptr<HintEngine<Rules>> hints;
+
+    // Every bid entered, by seat and situation; feeds the advisor's chance nodes
+    BidModel bidModel;
+
     /***************************************************************************
      * GAME STATE DISPLAY
      ***************************************************************************/
-    
+
     void displayGameState() const {
-        cout << "\n" << string(60, '=') << endl;
-        cout << "           SPLIT UNO - GAME STATE" << endl;
-        cout << string(60, '=') << endl;
-        
-        for (const auto& p : players) {
-            cout << left << setw(15) << p.name 
-                 << ": " << setw(2) << p.numberCards << " Num | " 
-                 << setw(2) << p.actionCards << " Act";
-            if (p.isBlocked) cout << " [BLOCKED]";
-            if (p.consecutiveWins > 0) cout << " (Wins: " << p.consecutiveWins << ")";
-            cout << endl;
-        }
-        
-        cout << "\nDeck Remaining: Numbers=" << numberDeckRemaining 
-             << " | Actions=" << actionDeckRemaining << endl;
-        cout << string(60, '=') << "\n" << endl;
+        if (console.quiet) {
+            // One STATE line, then one PLAYER line per seat
+            out << "STATE round=" << engine.roundsPlayed() << " numberDeck=" << state.numberDeckRemaining
+                << " actionDeck=" << state.actionDeckRemaining << '\n';
+            for (int i = 0; i < state.numPlayers; ++i) {
+                out << "PLAYER seat=" << i + 1 << " name=" << names[i] << " number=" << state.numberCards[i]
+                    << " action=" << state.actionCards[i] << " wins=" << state.consecutiveWins[i]
+                    << " blocked=" << int(state.blocked[i]) << '\n';
+            }
+            return;
+        }
+        out << "\n" << string(60, '=') << '\n';
+        out << "           SPLIT UNO - GAME STATE\n";
+        out << string(60, '=') << '\n';
+
+        for (int i = 0; i < state.numPlayers; ++i) {
+            out << left << setw(15) << names[i]
+                << ": " << setw(2) << state.numberCards[i] << " Num | "
+                << setw(2) << state.actionCards[i] << " Act";
+            if (state.blocked[i]) out << " [BLOCKED]";
+            if (state.consecutiveWins[i] > 0) out << " (Wins: " << state.consecutiveWins[i] << ")";
+            out << '\n';
+        }
+
+        out << "\nDeck Remaining: Numbers=" << state.numberDeckRemaining
+            << " | Actions=" << state.actionDeckRemaining << '\n';
+        out << string(60, '=') << "\n\n";
     }
 
     /***************************************************************************
-     * NUMBER CARD ROUND HANDLERS
+     * ACTION CARD MENU
      ***************************************************************************/
-    
-    void handleNumberRound() {
-        vector<int> playedCards(players.size());
-        int maxCard = -1;
-        vector<int> winners;
-
-        // 1. Collect cards from all non-blocked players
-        for (size_t i = 0; i < players.size(); ++i) {
-            if (players[i].isBlocked) {
-                cout << ">>> " << players[i].name << " is BLOCKED and skips this round." << endl;
-                players[i].isBlocked = false; // Unblock for next round
-                playedCards[i] = -1; // Marker for no card
-                continue;
-            }
 
-            playedCards[i] = getValidatedInt(
-                "Enter " + players[i].name + "'s card (0-9): ", 
-                MIN_CARD_NUMBER, MAX_CARD_NUMBER
-            );
-
-            if (playedCards[i] > maxCard) {
-                maxCard = playedCards[i];
-                winners.clear();
-                winners.push_back(i);
-            } else if (playedCards[i] == maxCard) {
-                winners.push_back(i);
-            }
-        }
+    void handleActionCard(Engine& target) {
+        int playerIdx = console.getValidatedPlayerIndex("Who is playing an action card?");
 
-        // 2. Process Special Effects (0 and 7)
-        for (size_t i = 0; i < players.size(); ++i) {
-            if (playedCards[i] == 0) {
-                cout << "\n>>> " << players[i].name << " played 0! Steal 1 card." << endl;
-                int targetIdx = getValidatedPlayerIndex("Who to steal from?", i);
-                if (players[targetIdx].numberCards > 0) {
-                    players[i].numberCards++;
-                    players[targetIdx].numberCards--;
-                    cout << ">>> Stolen 1 card from " << players[targetIdx].name << "." << endl;
-                } else {
-                    cout << ">>> Target has no cards to steal!" << endl;
-                }
-            }
-            if (playedCards[i] == 7) {
-                cout << "\n>>> " << players[i].name << " played 7! Target draws penalty." << endl;
-                int targetIdx = getValidatedPlayerIndex("Who draws penalty?", i);
-                int numDrawn = drawFromNumberDeck(CARD_7_NUMBER_DRAW);
-                int actDrawn = drawFromActionDeck(CARD_7_ACTION_DRAW);
-                players[targetIdx].numberCards += numDrawn;
-                players[targetIdx].actionCards += actDrawn;
-                cout << ">>> " << players[targetIdx].name << " draws " 
-                     << numDrawn << " Num and " << actDrawn << " Act cards." << endl;
-            }
-        }
+        ActionType type = console.getValidatedAction(
+            Rules::TRUTH_DARE_ENABLED
+                ? "Enter action card type (BLOCK/REVERSE/COLOR/+2/+4/TRUTH/DARE): "
+                : "Enter action card type (BLOCK/REVERSE/COLOR/+2/+4): ",
+            Engine::isPlayable);
+        if (console.inputClosed) return;
+        target.dispatchAction(playerIdx, type);
+    }
 
-        // 3. Resolve Winner
-        if (winners.empty()) {
-            cout << ">>> All players were blocked! No winner." << endl;
-            return;
-        }
+    void manualAdjustment() {
+        if (!console.quiet) out << "\n--- Manual Adjustment ---\n";
+        int pIdx = console.getValidatedPlayerIndex("Select player to adjust:");
 
-        if (winners.size() == 1) {
-            int winnerIdx = winners[0];
-            cout << "\n>>> " << players[winnerIdx].name << " WINS the round with " << maxCard << "!" << endl;
-            
-            // Winner sheds 1 card
-            players[winnerIdx].numberCards = max(0, players[winnerIdx].numberCards - 1);
-            players[winnerIdx].consecutiveWins++;
-
-            // Reset others' consecutive wins and make them draw penalty
-            for (size_t i = 0; i < players.size(); ++i) {
-                if (static_cast<int>(i) != winnerIdx && playedCards[i] != -1) {
-                    players[i].consecutiveWins = 0;
-                    int drawn = drawFromNumberDeck(1);
-                    players[i].numberCards += drawn;
-                }
-            }
+        if (!console.quiet) out << "1. Number Cards\n2. Action Cards\n3. Reset Wins\n";
+        int choice = console.getValidatedInt("Choice: ", 1, 3);
+
+        if (choice == 1) {
+            state.numberCards[pIdx] = console.getValidatedInt("New Count: ", 0, 100);
+        } else if (choice == 2) {
+            state.actionCards[pIdx] = console.getValidatedInt("New Count: ", 0, 50);
         } else {
-            cout << "\n>>> TIE between ";
-            for (size_t i = 0; i < winners.size(); ++i) {
-                cout << players[winners[i]].name << (i < winners.size()-1 ? ", " : "");
-                // Tied players shed 1 card
-                players[winners[i]].numberCards = max(0, players[winners[i]].numberCards - 1);
-                players[winners[i]].consecutiveWins = 0; // Reset consecutive on tie? Rules ambiguous, resetting for balance.
-            }
-            cout << "!" << endl;
-            cout << ">>> Tied players shed 1 card. All players draw 1 card." << endl; // House rule for ties
-            
-            for (auto& p : players) {
-                p.numberCards += drawFromNumberDeck(1);
-            }
+            state.consecutiveWins[pIdx] = 0;
         }
-
-        checkConsecutiveWins();
-        checkWinCondition();
     }
 
     /***************************************************************************
-     * ACTION CARD HANDLERS
+     * SAVED GAMES
      ***************************************************************************/
-    
-    void handleActionCard() {
-        int playerIdx = getValidatedPlayerIndex("Who is playing an action card?");
-        
-        string actionStr = getValidatedString(
-            "Enter action card type (BLOCK/REVERSE/COLOR/+2/+4/TRUTH/DARE): ",
-            {"BLOCK", "SKIP", "REVERSE", "COLOR", "WILD", "+2", "+4", "TRUTH", "DARE"}
-        );
-        ActionType type = parseActionType(actionStr);
-
-        switch (type) {
-            case ActionType::BLOCK:
-            case ActionType::SKIP:
-                handleBlockCard(playerIdx);
-                break;
-            case ActionType::REVERSE:
-                handleReverseCard(playerIdx);
-                break;
-            case ActionType::COLOR_CHANGE:
-            case ActionType::WILD:
-                handleColorChangeCard(playerIdx);
-                break;
-            case ActionType::DRAW_TWO:
-                handleDrawCard(playerIdx, 2);
-                break;
-            case ActionType::DRAW_FOUR:
-                handleDrawCard(playerIdx, 4);
-                break;
-            case ActionType::TRUTH:
-                handleTruthCard(playerIdx);
-                break;
-            case ActionType::DARE:
-                handleDareCard(playerIdx);
-                break;
-            default:
-                cout << ">>> Error: Unknown action type." << endl;
-        }
+
+    bool saveTo(const string& path, string& error) const {
+        SavedGame game{state, engine.roundsPlayed(), names};
+        return saveGame(path, game, rulesFingerprint<Rules>(tables), error);
     }
 
-    void handleBlockCard(int playerIdx) {
-        cout << "\n>>> " << players[playerIdx].name << " plays BLOCK!" << endl;
-        int targetIdx = getValidatedPlayerIndex("Who to BLOCK?", playerIdx);
-        
-        string counter = getValidatedString(
-            "Did " + players[targetIdx].name + " play a BLOCK to counter? (Y/N): ",
-            {"Y", "N", "YES", "NO"}
-        );
+    bool loadFrom(const string& path, string& error) {
+        SavedGame game;
+        if (!loadGame(path, rulesFingerprint<Rules>(tables), game, error)) return false;
+        engine.restore(game.state, game.rounds);
+        names = game.names;
+        history.reset(state, engine.roundsPlayed());  // Seats may differ, so no undo past a load
+        branches.clear();
+        bidModel.clear();
+        // The round log's columns are fixed to the player count it was opened with
+        if (roundLog.isOpen() && roundLog.numPlayers() != state.numPlayers) {
+            roundLog.close();
+            engine.attachRoundLog(nullptr, 0);
+            console.say(">>> WARNING: Player count changed; rounds are no longer recorded.");
+        }
+        return true;
+    }
 
-        if (counter == "Y" || counter == "YES") {
-            cout << ">>> Countered! Both shed 1 Number Card." << endl;
-            players[playerIdx].numberCards = max(0, players[playerIdx].numberCards - 1);
-            players[targetIdx].numberCards = max(0, players[targetIdx].numberCards - 1);
-            players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
-            players[targetIdx].actionCards = max(0, players[targetIdx].actionCards - 1);
+    void saveMenu() {
+        string path = console.getLine("Save to [" + savePath + "]: ", savePath);
+        string error;
+        if (saveTo(path, error)) {
+            savePath = path;
+            console.say(">>> Game saved to ", path, ".");
         } else {
-            cout << ">>> " << players[targetIdx].name << " is BLOCKED for next round!" << endl;
-            players[targetIdx].isBlocked = true;
-            players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
-        }
-    }
-
-    void handleReverseCard(int playerIdx) {
-        cout << "\n>>> " << players[playerIdx].name << " plays REVERSE (Swap Hands)!" << endl;
-        int targetIdx = getValidatedPlayerIndex("Who to swap hands with?", playerIdx);
-        
-        cout << ">>> Swapping hands between " << players[playerIdx].name 
-             << " and " << players[targetIdx].name << "!" << endl;
-             
-        swap(players[playerIdx].numberCards, players[targetIdx].numberCards);
-        swap(players[playerIdx].actionCards, players[targetIdx].actionCards);
-        
-        // Player who played it sheds the card (from their NEW hand count? Or old? 
-        // Usually you play then swap. So decrement first.)
-        // Actually, if I swap counts, the card I played is gone from my old hand.
-        // But now I have the opponent's hand. 
-        // Let's assume the card is discarded BEFORE the swap.
-        // But wait, I just swapped. So I need to decrement from the TARGET's hand 
-        // (which is now my old hand) or just decrement my current hand?
-        // Logic: I play card -> Count - 1. Then Swap.
-        // So:
-        // 1. Decrement player's action card count (the card played).
-        players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
-        // 2. Swap.
-        swap(players[playerIdx].numberCards, players[targetIdx].numberCards);
-        swap(players[playerIdx].actionCards, players[targetIdx].actionCards);
-    }
-
-    void handleColorChangeCard(int playerIdx) {
-        cout << "\n>>> " << players[playerIdx].name << " plays COLOR CHANGE!" << endl;
-        cout << ">>> All players shed 1 Number Card." << endl;
-        
-        for (auto& p : players) {
-            p.numberCards = max(0, p.numberCards - 1);
-        }
-        
-        string color = getValidatedString(
-            "Enter chosen color (R/Y/G/B): ",
-            {"R", "Y", "G", "B", "RED", "YELLOW", "GREEN", "BLUE"}
-        );
-        cout << ">>> Next player must play " << color << "." << endl;
-        players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
-    }
-
-    void handleDrawCard(int playerIdx, int amount) {
-        cout << "\n>>> " << players[playerIdx].name << " plays +" << amount << "!" << endl;
-        int targetIdx = getValidatedPlayerIndex("Who to attack?", playerIdx);
-        
-        // Check for counter
-        string hasCounter = getValidatedString(
-            "Did " + players[targetIdx].name + " counter with +2/+4? (Y/N): ",
-            {"Y", "N", "YES", "NO"}
-        );
-
-        if (hasCounter == "Y" || hasCounter == "YES") {
-            string oppCard = getValidatedString("Enter counter card (+2/+4): ", {"+2", "+4"});
-            int oppAmount = (oppCard == "+2") ? 2 : 4;
-            
-            int diff = abs(amount - oppAmount);
-            int loserDraw = 1 + diff;
-
-            if (amount > oppAmount) {
-                cout << ">>> " << players[playerIdx].name << " wins counter! " 
-                     << players[targetIdx].name << " draws " << loserDraw << "." << endl;
-                players[targetIdx].numberCards += drawFromNumberDeck(loserDraw);
-            } else if (oppAmount > amount) {
-                cout << ">>> " << players[targetIdx].name << " wins counter! " 
-                     << players[playerIdx].name << " draws " << loserDraw << "." << endl;
-                players[playerIdx].numberCards += drawFromNumberDeck(loserDraw);
-            } else {
-                cout << ">>> Tie! Both shed action card and draw 1 Number Card." << endl;
-                players[playerIdx].numberCards += drawFromNumberDeck(1);
-                players[targetIdx].numberCards += drawFromNumberDeck(1);
-            }
-            // Both shed their action cards
-            players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
-            players[targetIdx].actionCards = max(0, players[targetIdx].actionCards - 1);
+            console.say(">>> Error: ", error, ".");
+        }
+    }
+
+    void loadMenu() {
+        string path = console.getLine("Load from [" + savePath + "]: ", savePath);
+        string error;
+        if (loadFrom(path, error)) {
+            savePath = path;
+            console.say(">>> Game loaded from ", path, ".");
+            displayGameState();
         } else {
-            cout << ">>> " << players[targetIdx].name << " takes the hit! Draws " << amount << "." << endl;
-            players[targetIdx].numberCards += drawFromNumberDeck(amount);
-            players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
+            console.say(">>> Error: ", error, ".");
         }
     }
 
-    void handleTruthCard(int playerIdx) {
-        cout << "\n>>> " << players[playerIdx].name << " plays TRUTH!" << endl;
-        int targetIdx = getValidatedPlayerIndex("Who to ask?", playerIdx);
-        
-        string response = getValidatedString(
-            "Did " + players[targetIdx].name + " answer? (Y/N): ",
-            {"Y", "N", "YES", "NO"}
-        );
+    /***************************************************************************
+     * UNDO / REDO
+     ***************************************************************************/
 
-        if (response == "N" || response == "NO") {
-            int choice = getValidatedInt(
-                "Penalty Choice:\n1. Attacker gets 2 Action, Target gets 2 Number\n2. Target gets 5 Number\nChoice: ", 1, 2);
-            
-            if (choice == 1) {
-                players[playerIdx].actionCards += drawFromActionDeck(2);
-                players[targetIdx].numberCards += drawFromNumberDeck(2);
-            } else {
-                players[targetIdx].numberCards += drawFromNumberDeck(5);
-            }
+    void undoStep() {
+        GameState previous = state;
+        uint32_t rounds = 0;
+        if (!history.undo(previous, rounds, bidModel)) {
+            console.say(">>> Nothing to undo.");
+            return;
         }
-        
-        players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
-        players[playerIdx].numberCards = max(0, players[playerIdx].numberCards - 1);
+        engine.restore(previous, rounds);
+        console.say(">>> Undone.");
+        displayGameState();
     }
 
-    void handleDareCard(int playerIdx) {
-        cout << "\n>>> " << players[playerIdx].name << " plays DARE!" << endl;
-        int targetIdx = getValidatedPlayerIndex("Who to dare?", playerIdx);
-        
-        string response = getValidatedString(
-            "Did " + players[targetIdx].name + " complete the dare? (Y/N): ",
-            {"Y", "N", "YES", "NO"}
-        );
-
-        if (response == "N" || response == "NO") {
-            cout << ">>> " << players[targetIdx].name << " FORFEITS! " << players[playerIdx].name << " WINS!" << endl;
-            gameOver = true;
-            winner = players[playerIdx].name;
-        } else {
-            players[playerIdx].actionCards = max(0, players[playerIdx].actionCards - 1);
-            players[playerIdx].numberCards = max(0, players[playerIdx].numberCards - 1);
+    void redoStep() {
+        GameState next = state;
+        uint32_t rounds = 0;
+        if (!history.redo(next, rounds, bidModel)) {
+            console.say(">>> Nothing to redo.");
+            return;
         }
+        engine.restore(next, rounds);
+        console.say(">>> Redone.");
+        displayGameState();
     }
 
     /***************************************************************************
-     * GAME FLOW LOGIC
+     * WHAT-IF SANDBOX
      ***************************************************************************/
-    
-    void checkConsecutiveWins() {
-        for (auto& p : players) {
-            if (p.consecutiveWins >= CONSECUTIVE_WINS_THRESHOLD) {
-                cout << "\n>>> " << p.name << " has " << CONSECUTIVE_WINS_THRESHOLD << " consecutive wins!" << endl;
-                int choice = getValidatedInt(
-                    "Choose: (1) Draw 1 Action Card OR (2) All opponents draw 2 Number Cards: ", 1, 2);
-                
-                if (choice == 1) {
-                    p.actionCards += drawFromActionDeck(1);
+
+    Branch& fork(const Engine& from) {
+        auto branch = make_unique<Branch>(Branch{"W" + to_string(nextBranchId++), Engine(tables, console)});
+        branch->engine.restore(from.gameState(), from.roundsPlayed());
+        branches.push_back(move(branch));
+        return *branches.back();
+    }
+
+    // Asks for a branch; 0 is the live game
+    int pickBranch(const string& prompt, bool allowLive) {
+        out << prompt << '\n';
+        if (allowLive && !console.quiet) out << "  (0) live game\n";
+        for (size_t b = 0; b < branches.size() && !console.quiet; ++b) {
+            out << "  (" << b + 1 << ") " << branches[b]->label << '\n';
+        }
+        return console.getValidatedInt("Select Branch: ", allowLive ? 0 : 1, static_cast<int>(branches.size()));
+    }
+
+    // Card counts of the live game and every branch in adjacent columns
+    void compareBranches() const {
+        out << "\n" << left << setw(15) << "Num/Act" << setw(12) << "live";
+        for (const auto& b : branches) out << setw(12) << b->label;
+        out << '\n';
+        auto cell = [](const GameState& g, int i) {
+            string text = to_string(g.numberCards[i]) + "/" + to_string(g.actionCards[i]);
+            if (g.blocked[i]) text += " B";
+            if (g.gameOver && g.winner == i) text += " W";
+            return text;
+        };
+        for (int i = 0; i < state.numPlayers; ++i) {
+            out << setw(15) << names[i] << setw(12) << cell(state, i);
+            for (const auto& b : branches) out << setw(12) << cell(b->engine.gameState(), i);
+            out << '\n';
+        }
+        auto decks = [](const GameState& g) {
+            return to_string(g.numberDeckRemaining) + "/" + to_string(g.actionDeckRemaining);
+        };
+        out << setw(15) << "Decks" << setw(12) << decks(state);
+        for (const auto& b : branches) out << setw(12) << decks(b->engine.gameState());
+        out << '\n';
+    }
+
+    void sandbox() {
+        while (true) {
+            if (!console.quiet) {
+                out << "\n--- WHAT-IF SANDBOX (" << branches.size() << " branches) ---\n";
+                out << "1. Fork\n2. Number Round in Branch\n3. Action Card in Branch\n4. Compare\n"
+                    << "5. Adopt Branch as Live Game\n6. Discard Branch\n7. Back\n";
+            }
+            int choice = console.getValidatedInt("Choice: ", 1, 7);
+            if (choice == 7 || console.inputClosed) return;
+            if (choice == 1) {
+                int from = branches.empty() ? 0 : pickBranch("Fork which game?", true);
+                Branch& b = fork(from == 0 ? engine : branches[from - 1]->engine);
+                console.say(">>> Forked ", from == 0 ? string("live game") : branches[from - 1]->label, " into ",
+                            b.label, ".");
+                continue;
+            }
+            if (choice == 4) {
+                compareBranches();
+                continue;
+            }
+            if (branches.empty()) {
+                console.say(">>> No branches yet. Fork the live game first.");
+                continue;
+            }
+
+            int pick = pickBranch("Which branch?", false) - 1;
+            Branch& b = *branches[pick];
+            if (choice == 2 || choice == 3) {
+                if (b.engine.gameState().gameOver) {
+                    console.say(">>> ", b.label, " has already ended.");
+                    continue;
+                }
+                console.say(">>> [", b.label, "]");
+                if (choice == 2) {
+                    b.engine.handleNumberRound();
                 } else {
-                    for (auto& opp : players) {
-                        if (opp.name != p.name) {
-                            opp.numberCards += drawFromNumberDeck(2);
-                        }
-                    }
+                    handleActionCard(b.engine);
                 }
-                p.consecutiveWins = 0;
+                compareBranches();
+            } else if (choice == 5) {
+                engine.restore(b.engine.gameState(), b.engine.roundsPlayed());
+                history.commit(state, engine.roundsPlayed());
+                console.say(">>> ", b.label, " is now the live game.");
+                displayGameState();
+                if (state.gameOver) return;
+            } else {
+                console.say(">>> Discarded ", b.label, ".");
+                branches.erase(branches.begin() + pick);
             }
         }
     }
-    
-    void handleDrawChallenge(int winnerIdx) {
-        // Check if any other player wants to challenge
-        cout << "\n>>> " << players[winnerIdx].name << " has 0 cards! Checking for challenges..." << endl;
-        
-        string challenge = getValidatedString("Any challenges? (Y/N): ", {"Y", "N", "YES", "NO"});
-        if (challenge == "N" || challenge == "NO") {
-            gameOver = true;
-            winner = players[winnerIdx].name;
-            return;
+
+    /***************************************************************************
+     * ADVISOR
+     ***************************************************************************/
+
+    // A decision prompt opened: start pondering it and/or print advice
+    void decisionOpened(const GameState& s, Decision d, int decider, int amount) {
+        if (!Advisor<Rules>::supports(s.numPlayers)) return;
+        BidOdds odds = {bidModel.predict(s, 0), bidModel.predict(s, 1)};
+        if (hints) hints->start(s, d, decider, amount, odds);
+        if (advisor) showAdvice(s, d, decider, amount, odds);
+    }
+
+    void showAdvice(const GameState& s, Decision d, int decider, int amount, const BidOdds& odds) {
+        auto start = chrono::steady_clock::now();
+        for (int seat = 0; seat < s.numPlayers; ++seat) advisor->setBidOdds(seat, odds[seat]);
+        Advice a = advisor->advise(s, d, decider, amount);
+        auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+        printAdvice("Advisor", a, d, decider, to_string(ms) + " ms");
+    }
+
+    // Best ranking found so far by the background search, without waiting
+    void showHint() const {
+        HintStatus h = hints->current();
+        if (!h.open) {
+            out << ">>> No hint here: hints cover counters, the TRUTH penalty, the streak bonus and challenges"
+                << " in 2-player games.\n";
+        } else if (h.advice.count == 0) {
+            out << ">>> Hint: still starting, ask again in a moment.\n";
+        } else {
+            printAdvice("Hint", h.advice, h.decision, h.decider, h.searching ? "still searching" : "search complete");
         }
+    }
 
-        int challengerIdx = getValidatedPlayerIndex("Who is challenging?", winnerIdx);
-        
-        // Logic: Challenger plays +2/+4. Winner must draw unless they have counter?
-        // Simplified: If valid challenge, winner draws.
-        string cardType = getValidatedString("Challenge card (+2/+4): ", {"+2", "+4"});
-        int amount = (cardType == "+2") ? 2 : 4;
-        
-        cout << ">>> Challenge accepted! " << players[winnerIdx].name << " draws " << amount << "." << endl;
-        players[winnerIdx].numberCards += drawFromNumberDeck(amount);
-        players[challengerIdx].actionCards = max(0, players[challengerIdx].actionCards - 1);
-    }
-    
-    void checkWinCondition() {
-        for (size_t i = 0; i < players.size(); ++i) {
-            if (players[i].numberCards == 0) {
-                handleDrawChallenge(i);
-                if (gameOver) return;
-            }
+    void printAdvice(const char* label, const Advice& a, Decision d, int decider, const string& detail) const {
+        // Best option first
+        array<int, Advice::MAX_OPTIONS> order = {0, 1, 2};
+        for (int i = 1; i < a.count; ++i) {
+            for (int j = i; j > 0 && a.value[order[j]] > a.value[order[j - 1]]; --j) swap(order[j], order[j - 1]);
         }
+        out << ">>> " << label << " for " << names[decider] << " (" << a.depth << " rounds ahead, " << detail << "):";
+        for (int i = 0; i < a.count; ++i) {
+            out << (i ? " |" : "") << " " << describeOption(d, a.option[order[i]]) << " " << showpos << fixed
+                << setprecision(2) << a.value[order[i]] << noshowpos;
+        }
+        out << '\n';
     }
-    
-    void manualAdjustment() {
-        cout << "\n--- Manual Adjustment ---" << endl;
-        int pIdx = getValidatedPlayerIndex("Select player to adjust:");
-        
-        cout << "1. Number Cards\n2. Action Cards\n3. Reset Wins" << endl;
-        int choice = getValidatedInt("Choice: ", 1, 3);
-        
-        if (choice == 1) {
-            players[pIdx].numberCards = getValidatedInt("New Count: ", 0, 100);
-        } else if (choice == 2) {
-            players[pIdx].actionCards = getValidatedInt("New Count: ", 0, 50);
+
+    void openRoundLog() {
+        if (roundLogPath.empty()) return;
+        string error;
+        if (roundLog.open(roundLogPath, state.numPlayers, error)) {
+            engine.attachRoundLog(&roundLog, 0);
         } else {
-            players[pIdx].consecutiveWins = 0;
+            console.say(">>> WARNING: ", error, ". Rounds will not be recorded.");
         }
     }
 
 public:
-    SplitUnoArbiter() {
-        numberDeckRemaining = INITIAL_NUMBER_DECK;
-        actionDeckRemaining = INITIAL_ACTION_DECK;
-        gameOver = false;
+    SplitUnoArbiter(const RuleTables& rules, const string& roundLogFile, const string& saveFile, bool autosaveOn,
+                    uint32_t adviseMs, bool hintsOn, bool quiet)
+        : tables(rules), console(tables, out, quiet), engine(tables, console), state(engine.gameState()),
+          names(console.names), roundLogPath(roundLogFile),
+          savePath(saveFile.empty() ? "split_uno.sav" : saveFile), autosave(autosaveOn) {
+        cin.tie(&out);
+        engine.attachBidModel(&bidModel);
+        if (adviseMs > 0) {
+            AdvisorSettings settings;
+            settings.budgetMs = adviseMs;
+            advisor = make_unique<Advisor<Rules>>(tables, settings);
+        }
+        if (hintsOn) {
+            hints = make_unique<HintEngine<Rules>>(tables);
+            console.decided = [this] { hints->cancel(); };
+            console.hint = [this] { showHint(); };
+        }
+        if (advisor || hints) {
+            console.advise = [this](const GameState& s, Decision d, int decider, int amount) {
+                decisionOpened(s, d, decider, amount);
+            };
+        }
     }
-    
+
+    ~SplitUnoArbiter() { cin.tie(&cout); }
+
+    void setDeadlines(const TurnDeadlines& d) { console.deadlines = d; }
+
+    // Continues a saved game instead of asking for a new setup in run().
+    bool resume(const string& path, string& error) {
+        resumed = loadFrom(path, error);
+        if (resumed) savePath = path;
+        return resumed;
+    }
+
     void setupGame() {
-        cout << "\n";
-        cout << "╔════════════════════════════════════════════════════════════╗\n";
-        cout << "║          SPLIT UNO ARBITER - GAME TRACKER v3.0             ║\n";
-        cout << "╚════════════════════════════════════════════════════════════╝\n";
-        
-        cout << ">>> STRICTLY 2 PLAYERS MODE <<<\n";
-        int numPlayers = 2;
+        if (!console.quiet) {
+            out << "\n";
+            out << "╔════════════════════════════════════════════════════════════╗\n";
+            out << "║          SPLIT UNO ARBITER - GAME TRACKER v3.0             ║\n";
+            out << "╚════════════════════════════════════════════════════════════╝\n";
+        }
+
+        console.say(">>> RULES: ", Rules::NAME, " <<<");
+        int numPlayers = console.getValidatedInt(
+            "Enter number of players (" + to_string(MIN_PLAYERS) + "-" + to_string(MAX_PLAYERS) + "): ",
+            MIN_PLAYERS, MAX_PLAYERS);
+        engine.newGame(numPlayers);
+        names.clear();
         for (int i = 1; i <= numPlayers; ++i) {
             string name;
-            cout << "Enter name for Player " << i << ": ";
+            out << "Enter name for Player " << i << ": ";
             cin >> name;
-            players.emplace_back(name, INITIAL_CARDS);
+            names.push_back(name);
         }
-        clearInputBuffer(); // Clear newline after name inputs
+        console.clearInputBuffer(); // Clear newline after name inputs
     }
-    
+
     void run() {
-        setupGame();
+        if (resumed) {
+            console.say(">>> RESUMED: ", Rules::NAME, " rules, round ", engine.roundsPlayed(), " <<<");
+        } else {
+            setupGame();
+        }
+        openRoundLog();
+        history.reset(state, engine.roundsPlayed());
         displayGameState();
-        
-        while (!gameOver) {
-            cout << "\n--- NEW ROUND ---" << endl;
-            cout << "1. Number Round\n2. Action Card\n3. Display State\n4. Adjust\n5. End Game" << endl;
-            int choice = getValidatedInt("Choice: ", 1, 5);
-            
+
+        while (!state.gameOver) {
+            if (!console.quiet) {
+                out << "\n--- NEW ROUND ---\n";
+                out << "1. Number Round\n2. Action Card\n3. Display State\n4. Adjust\n5. End Game\n"
+                    << "6. Save Game\n7. Load Game\n8. Undo\n9. Redo\n10. What-If Sandbox\n";
+            }
+            int choice = console.getValidatedInt("Choice: ", 1, 10);
+            if (console.inputClosed) break;
+
             switch (choice) {
-                case 1: handleNumberRound(); break;
-                case 2: handleActionCard(); break;
+                case 1: engine.handleNumberRound(); break;
+                case 2: handleActionCard(engine); break;
                 case 3: displayGameState(); break;
                 case 4: manualAdjustment(); break;
-                case 5: gameOver = true; break;
+                case 5: state.gameOver = true; break;
+                case 6: saveMenu(); break;
+                case 7: loadMenu(); break;
+                case 8: undoStep(); break;
+                case 9: redoStep(); break;
+                case 10: sandbox(); break;
             }
-            
-            if (!gameOver && (choice == 1 || choice == 2)) {
+            if (console.inputClosed) break;  // Ran out of input mid-step; keep the last complete state
+
+            if (choice == 1) roundLog.flush();  // Written as played, so a crash or Ctrl-C loses no rounds
+            bool changed = choice == 1 || choice == 2 || choice == 4 || choice >= 7;
+            if (choice == 1 || choice == 2 || choice == 4) {
+                history.commit(state, engine.roundsPlayed(), bidModel.takeChanges());
+            }
+            if (autosave && changed) {
+                string error;
+                if (!saveTo(savePath, error)) console.say(">>> WARNING: Autosave failed: ", error, ".");
+            }
+            if (!state.gameOver && (choice == 1 || choice == 2)) {
                 displayGameState();
             }
         }
-        
-        if (!winner.empty()) {
-            cout << "\n🏆 WINNER: " << winner << " 🏆\n" << endl;
+
+        if (state.winner != NO_WINNER) {
+            if (console.quiet) {
+                out << "WINNER seat=" << state.winner + 1 << " name=" << names[state.winner] << '\n';
+            } else {
+                out << "\n🏆 WINNER: " << names[state.winner] << " 🏆\n\n";
+            }
         }
     }
 };
 
-int main() {
-    SplitUnoArbiter arbiter;
+/*******************************************************************************
+ * COMMAND LINE
+ ******************************************************************************/
+
+struct Options {
+    string variant = "standard";
+    string rulesFile;
+    string roundLogFile;
+    string saveFile;
+    string resumeFile;
+    uint32_t adviseMs = 0;
+    bool hints = false;
+    bool quiet = false;
+    TurnDeadlines deadlines;
+    bool benchEval = false;
+    bool benchLockstep = false;
+    string benchPoolDir;
+    string sweepGrid;
+    SweepSettings sweep;
+    string tournamentBots;
+    TournamentSettings tournament;
+    bool modelCheck = false;
+    ModelCheckSettings check;
+};
+
+// Plays the same LockstepBot games through the engine and every lockstep
+// kernel and reports the throughput
+template <typename Rules>
+int benchmarkLockstep(const RuleTables& tables) {
+    constexpr size_t GAMES = 1 << 15;
+    vector<uint64_t> seeds(GAMES);
+    for (size_t g = 0; g < GAMES; ++g) seeds[g] = splitMix64(g);
+
+    vector<GameResult> reference(GAMES), results(GAMES);
+    uint64_t enginePlayed = 0;
+    auto start = chrono::steady_clock::now();
+    double engineSeconds = 0.0;
+    while (engineSeconds < 0.25) {
+        for (size_t g = 0; g < GAMES; ++g) {
+            LockstepBot bot(seeds[g]);
+            reference[g] = playGameWith<Rules>(bot, tables, 2);
+        }
+        enginePlayed += GAMES;
+        engineSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    double engineRate = static_cast<double>(enginePlayed) / engineSeconds;
+    cout << left << setw(8) << "engine" << right << fixed << setprecision(2) << setw(8) << engineRate / 1e6
+         << " M games/s\n";
+
+    const pair<const char*, LockstepKernel> kernels[] = {
+        {"generic", LockstepKernel::GENERIC}, {"auto", LockstepKernel::AUTO}};
+    for (const auto& kernel : kernels) {
+        uint64_t played = 0;
+        start = chrono::steady_clock::now();
+        double seconds = 0.0;
+        while (seconds < 0.25) {
+            playLockstepGames<Rules>(tables, LockstepPolicy::uniform(), seeds.data(), GAMES, results.data(),
+                                     kernel.second);
+            played += GAMES;
+            seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+        size_t mismatches = 0;
+        for (size_t g = 0; g < GAMES; ++g) {
+            mismatches += results[g].winner != reference[g].winner || results[g].rounds != reference[g].rounds;
+        }
+        double rate = static_cast<double>(played) / seconds;
+        cout << left << setw(8) << kernel.first << right << fixed << setprecision(2) << setw(8) << rate / 1e6
+             << " M games/s  " << setprecision(1) << rate / engineRate << "x";
+        if (mismatches) cout << "  (" << mismatches << " MISMATCHES against the engine)";
+        cout << "\n";
+    }
+    return 0;
+}
+
+// Churns games through a GamePool and hibernates and wakes them through a
+// GameStore in dir, checking handles, names and states on the way, and
+// reports the throughput. Exit status 1 if a check fails.
+template <typename Rules>
+int benchmarkPool(const RuleTables& tables, const string& dir) {
+    constexpr uint32_t GAMES = 1 << 14;
+    constexpr int CYCLES = 16;
+    vector<string> failures;
+    auto seatNames = [](int cycle, uint32_t g) {
+        // Same lengths every cycle, so the names fit the chunks freed before
+        return vector<string>{to_string(100 + cycle) + "-" + to_string(100000 + g), "shared", "p" + to_string(g % 512)};
+    };
+
+    // Every cycle deals GAMES games with names never seen before and ends
+    // them all, so the pool must end each cycle as large as after the first.
+    GamePool pool;
+    vector<GameHandle> handles(GAMES);
+    uint32_t capacity = 0;
+    size_t nameBytes = 0;
+    auto start = chrono::steady_clock::now();
+    for (int cycle = 0; cycle < CYCLES; ++cycle) {
+        for (uint32_t g = 0; g < GAMES; ++g) handles[g] = pool.create(tables, seatNames(cycle, g));
+        for (uint32_t g = 0; g < GAMES; ++g) {
+            const GameSlot* slot = pool.find(handles[g]);
+            if (!slot || pool.name(*slot, 0) != seatNames(cycle, g)[0]) {
+                failures.push_back("game " + to_string(g) + " lost its slot or names");
+                break;
+            }
+        }
+        for (uint32_t g = 0; g < GAMES; ++g) pool.release(handles[g]);
+        if (pool.find(handles[0]) || pool.release(handles[0])) failures.push_back("a released handle still works");
+        if (pool.size() != 0 || pool.namesInUse().size() != 0) failures.push_back("games or names left after release");
+        if (cycle == 0) {
+            capacity = pool.capacity();
+            nameBytes = pool.namesInUse().bytesReserved();
+        } else if (pool.capacity() != capacity || pool.namesInUse().bytesReserved() != nameBytes) {
+            failures.push_back("pool grew on cycle " + to_string(cycle + 1) + " with no more games live");
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << left << setw(10) << "pool" << right << fixed << setprecision(2) << setw(8)
+         << CYCLES * double(GAMES) / seconds / 1e6 << " M games created and ended/s, " << capacity << " slots, "
+         << nameBytes / 1024 << " KiB of names\n";
+
+    // Hibernate every game, wake each one and compare it with the original
+    constexpr uint64_t STORED = 1024;
+    GameStore store(dir, rulesFingerprint<Rules>(tables), 10);
+    string error;
+    vector<GameState> states(STORED);
+    auto sameState = [](const GameState& a, const GameState& b) {
+        return a.numberCards == b.numberCards && a.actionCards == b.actionCards &&
+               a.consecutiveWins == b.consecutiveWins && a.blocked == b.blocked && a.numPlayers == b.numPlayers &&
+               a.numberDeckRemaining == b.numberDeckRemaining && a.actionDeckRemaining == b.actionDeckRemaining && a.gameOver == b.gameOver && a.winner == b.winner;
+    };
+    for (uint64_t id = 0; id < STORED && failures.empty(); ++id) {
+        if (!store.create(id, tables, seatNames(0, uint32_t(id)), 0, error)) failures.push_back(error);
+        GameSlot* slot = store.open(id, 0, error);
+        if (!slot) {
+            failures.push_back(error);
+            break;
+        }
+        slot->state.numberCards[0] -= static_cast<int>(id % 7);
+        slot->rounds = static_cast<uint32_t>(id);
+        states[id] = slot->state;
+    }
+    start = chrono::steady_clock::now();
+    size_t asleep = failures.empty() ? store.hibernateIdle(10, error) : 0;
+    if (failures.empty() && (asleep != STORED || store.residentGames() != 0 || store.pool().namesInUse().size() != 0)) {
+        failures.push_back("hibernation left games resident" + (error.empty() ? string() : ": " + error));
+    }
+    for (uint64_t id = 0; id < STORED && failures.empty(); ++id) {
+        GameSlot* slot = store.open(id, 20, error);
+        if (!slot || !sameState(slot->state, states[id]) || slot->rounds != id ||
+            store.name(*slot, 0) != seatNames(0, uint32_t(id))[0]) {
+            failures.push_back("game " + to_string(id) + " did not wake as it was hibernated");
+        }
+    }
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    for (uint64_t id = 0; id < STORED; ++id) store.end(id, error);
+    if (failures.empty() && store.open(0, 30, error)) failures.push_back("an ended game could still be opened");
+    if (failures.empty()) {
+        cout << left << setw(10) << "store" << right << fixed << setprecision(2) << setw(8)
+             << STORED / seconds / 1e3 << " K games hibernated and woken/s\n";
+    }
+
+    for (const string& failure : failures) cout << "Pool check failed: " << failure << "\n";
+    return failures.empty() ? 0 : 1;
+}
+
+template <typename Rules>
+int runVariant(const Options& opts) {
+    RuleConfig config = RuleConfig::defaults<Rules>();
+    string error;
+    if (!opts.rulesFile.empty() && !config.loadFile(opts.rulesFile, error)) {
+        cerr << "Rules error: " << error << "\n";
+        return 1;
+    }
+
+    if (!opts.sweepGrid.empty()) {
+        vector<SweepAxis> axes;
+        if (!parseSweepGrid(opts.sweepGrid, config, axes, error)) {
+            cerr << "Sweep error: " << error << "\n";
+            return 1;
+        }
+        SweepSettings settings = opts.sweep;
+        BotPlugin plugin;
+        if (isPluginPath(settings.bot)) {
+            if (!plugin.open(settings.bot, error)) {
+                cerr << "Plugin error: " << error << "\n";
+                return 1;
+            }
+            settings.plugin = &plugin;
+        }
+        settings.record = opts.roundLogFile;
+        if (!runSweep<Rules>(config, axes, settings, cout, error)) {
+            cerr << "Sweep error: " << error << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!opts.tournamentBots.empty()) {
+        vector<unique_ptr<BotPlugin>> plugins;
+        vector<Entrant> entrants;
+        if (!parseEntrants(opts.tournamentBots, plugins, entrants, error)) {
+            cerr << "Tournament error: " << error << "\n";
+            return 1;
+        }
+        TournamentSettings settings = opts.tournament;
+        settings.gamesPerMatch = opts.sweep.games;
+        settings.threads = opts.sweep.threads;
+        settings.seed = opts.sweep.seed;
+        return runTournament<Rules>(config.tables(), entrants, settings, cout) ? 0 : 1;
+    }
+
+    if (opts.benchLockstep) return benchmarkLockstep<Rules>(config.tables());
+    if (!opts.benchPoolDir.empty()) return benchmarkPool<Rules>(config.tables(), opts.benchPoolDir);
+
+    if (opts.modelCheck) {
+        ModelCheckSettings settings = opts.check;
+        settings.numPlayers = opts.sweep.numPlayers;
+        settings.threads = opts.sweep.threads;
+        return printModelCheck<Rules>(config.tables(), settings, cout) ? 0 : 1;
+    }
+
+    SplitUnoArbiter<Rules> arbiter(config.tables(), opts.roundLogFile, opts.saveFile, !opts.saveFile.empty(),
+                                   opts.adviseMs, opts.hints, opts.quiet);
+    arbiter.setDeadlines(opts.deadlines);
+    if (!opts.resumeFile.empty() && !arbiter.resume(opts.resumeFile, error)) {
+        cerr << "Resume error: " << error << "\n";
+        return 1;
+    }
     arbiter.run();
     return 0;
-}
\ No newline at end of file
+}
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [--variant standard|speed|hardcore] [--rules FILE] [--record FILE]"
+         << " [--save FILE] [--resume FILE] [--advise MS] [--hints] [--quiet]\n"
+         << "         [--turn-timeout S] [--timeout-bid CARD] [--timeout-counter pass|+2|+4]"
+         << " [--timeout-block pass|block] [--timeout-challenge pass|+2|+4]\n"
+         << "       " << program << " --sweep GRID [--games N] [--players N] [--threads N] [--seed N]"
+         << " [--bot random|greedy|numbers|PLUGIN] [--events] [--precision W] [--record PATH]\n"
+         << "       " << program << " --tournament BOTS [--format swiss|round-robin] [--rounds N] [--games N]"
+         << " [--threads N] [--seed N]\n"
+         << "       " << program << " --model-check [--players N] [--cards N] [--depth N] [--threads N]\n"
+         << "       " << program << " --bench-eval\n"
+         << "       " << program << " --bench-lockstep [--variant V] [--rules FILE]\n"
+         << "       " << program << " --bench-pool DIR [--variant V] [--rules FILE]\n"
+         << "  GRID is KEY=v1,v2,...;KEY=... over house-rule keys, e.g.\n"
+         << "  \"INITIAL_CARDS=15,20;CONSECUTIVE_WINS_THRESHOLD=2,3\"\n"
+         << "  BOTS is a comma-separated list of random|greedy|PLUGIN (repeats allowed); --games is per match\n"
+         << "  PLUGIN is a bot library built against bot_abi.h, e.g. ./example_bot.so\n";
+}
+
+bool parseCount(const string& text, long long min, long long max, long long& out) {
+    try {
+        size_t used = 0;
+        long long value = stoll(text, &used);
+        if (used != text.size() || value < min || value > max) return false;
+        out = value;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Accepts "pass" (0), "+2" or "+4"
+bool parseTimeoutCard(const string& text, int& out) {
+    if (text != "pass" && text != "+2" && text != "+4") return false;
+    out = text == "pass" ? 0 : text[1] - '0';
+    return true;
+}
+
+// Accepts a probability width in (0, 0.5]
+bool parseFraction(const string& text, double& out) {
+    try {
+        size_t used = 0;
+        double value = stod(text, &used);
+        if (used != text.size() || !(value > 0.0 && value <= 0.5)) return false;
+        out = value;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Scores random states with every batch kernel and reports the throughput
+int benchmarkEvaluator() {
+    constexpr size_t STATES = 1 << 14;
+    const int deck = defaultRuleTables<StandardRules>().numberDeckAfterDeal(2);
+    Rng rng(1);
+    StateBatch batch;
+    for (size_t i = 0; i < STATES; ++i) {
+        GameState s{};
+        s.numPlayers = 2;
+        for (int p = 0; p < 2; ++p) {
+            s.numberCards[p] = rng.below(40);
+            s.actionCards[p] = rng.below(10);
+            s.consecutiveWins[p] = rng.below(3);
+            s.blocked[p] = rng.chance(10);
+        }
+        s.numberDeckRemaining = rng.below(deck + 1);
+        batch.push(s, rng.below(2));
+    }
+
+    EvalWeights weights;
+    const pair<const char*, EvalKernel> kernels[] = {
+        {"scalar", EvalKernel::SCALAR}, {"sse2", EvalKernel::SSE2}, {"avx2", EvalKernel::AVX2}, {"auto", EvalKernel::AUTO}};
+    vector<float> reference(STATES), scores(STATES);
+    evaluateBatch(batch, weights, deck, reference.data(), EvalKernel::SCALAR);
+    for (const auto& kernel : kernels) {
+        uint64_t evaluated = 0;
+        auto start = chrono::steady_clock::now();
+        double seconds = 0.0;
+        while (seconds < 0.25) {
+            for (int rep = 0; rep < 64; ++rep) evaluateBatch(batch, weights, deck, scores.data(), kernel.second);
+            evaluated += 64 * STATES;
+            seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+        bool same = equal(scores.begin(), scores.end(), reference.begin());
+        cout << left << setw(8) << kernel.first << right << fixed << setprecision(0) << setw(8)
+             << static_cast<double>(evaluated) / seconds / 1e6 << " M states/s"
+             << (same ? "" : "  (MISMATCH against scalar)") << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        long long value = 0;
+        double fraction = 0.0;
+        int card = 0;
+        if (arg == "--variant" && hasValue) {
+            opts.variant = argv[++i];
+        } else if (arg == "--rules" && hasValue) {
+            opts.rulesFile = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            opts.roundLogFile = argv[++i];
+        } else if (arg == "--save" && hasValue) {
+            opts.saveFile = argv[++i];
+        } else if (arg == "--resume" && hasValue) {
+            opts.resumeFile = argv[++i];
+        } else if (arg == "--advise" && hasValue && parseCount(argv[++i], 0, 60000, value)) {
+            opts.adviseMs = static_cast<uint32_t>(value);
+        } else if (arg == "--turn-timeout" && hasValue && parseCount(argv[++i], 1, 86400, value)) {
+            opts.deadlines.seconds = static_cast<uint32_t>(value);
+        } else if (arg == "--timeout-bid" && hasValue && parseCount(argv[++i], 0, NUM_CARD_VALUES - 1, value)) {
+            opts.deadlines.bidCard = static_cast<int>(value);
+        } else if (arg == "--timeout-counter" && hasValue && parseTimeoutCard(argv[++i], card)) {
+            opts.deadlines.counterCard = card;
+        } else if (arg == "--timeout-challenge" && hasValue && parseTimeoutCard(argv[++i], card)) {
+            opts.deadlines.challengeCard = card;
+        } else if (arg == "--timeout-block" && hasValue) {
+            string reply = argv[++i];
+            if (reply != "pass" && reply != "block") {
+                printUsage(argv[0]);
+                return 1;
+            }
+            opts.deadlines.blockCounter = reply == "block";
+        } else if (arg == "--quiet") {
+            opts.quiet = true;
+        } else if (arg == "--hints") {
+            opts.hints = true;
+        } else if (arg == "--bench-eval") {
+            opts.benchEval = true;
+        } else if (arg == "--bench-lockstep") {
+            opts.benchLockstep = true;
+        } else if (arg == "--bench-pool" && hasValue) {
+            opts.benchPoolDir = argv[++i];
+        } else if (arg == "--sweep" && hasValue) {
+            opts.sweepGrid = argv[++i];
+        } else if (arg == "--games" && hasValue && parseCount(argv[++i], 1, 1000000000LL, value)) {
+            opts.sweep.games = static_cast<uint64_t>(value);
+        } else if (arg == "--players" && hasValue && parseCount(argv[++i], MIN_PLAYERS, MAX_PLAYERS, value)) {
+            opts.sweep.numPlayers = static_cast<int>(value);
+        } else if (arg == "--threads" && hasValue && parseCount(argv[++i], 1, 1024, value)) {
+            opts.sweep.threads = static_cast<unsigned>(value);
+        } else if (arg == "--bot" && hasValue) {
+            opts.sweep.bot = argv[++i];
+            if (opts.sweep.bot != "random" && opts.sweep.bot != "greedy" && opts.sweep.bot != "numbers" &&
+                !isPluginPath(opts.sweep.bot)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--precision" && hasValue && parseFraction(argv[++i], fraction)) {
+            opts.sweep.precision = fraction;
+        } else if (arg == "--events") {
+            opts.sweep.events = true;
+        } else if (arg == "--tournament" && hasValue) {
+            opts.tournamentBots = argv[++i];
+        } else if (arg == "--format" && hasValue) {
+            string format = argv[++i];
+            if (format != "swiss" && format != "round-robin") {
+                printUsage(argv[0]);
+                return 1;
+            }
+            opts.tournament.format = format == "swiss" ? TournamentFormat::SWISS : TournamentFormat::ROUND_ROBIN;
+        } else if (arg == "--rounds" && hasValue && parseCount(argv[++i], 1, 1000, value)) {
+            opts.tournament.rounds = static_cast<int>(value);
+        } else if (arg == "--model-check") {
+            opts.modelCheck = true;
+        } else if (arg == "--cards" && hasValue && parseCount(argv[++i], 1, 20, value)) {
+            opts.check.cards = static_cast<int>(value);
+        } else if (arg == "--depth" && hasValue && parseCount(argv[++i], 1, 1000, value)) {
+            opts.check.maxDepth = static_cast<int>(value);
+        } else if (arg == "--seed" && hasValue && parseCount(argv[++i], 0, numeric_limits<long long>::max(), value)) {
+            opts.sweep.seed = static_cast<uint64_t>(value);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Deadlines look at what cin has buffered, which the stdio-synced stream
+    // never reports
+    if (opts.deadlines.seconds > 0) ios::sync_with_stdio(false);
+
+    if (opts.benchEval) return benchmarkEvaluator();
+    if (opts.variant == "standard") return runVariant<StandardRules>(opts);
+    if (opts.variant == "speed") return runVariant<SpeedRules>(opts);
+    if (opts.variant == "hardcore") return runVariant<HardcoreRules>(opts);
+    cerr << "Unknown variant: " << opts.variant << " (expected standard, speed or hardcore)\n";
+    return 1;
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * SPLIT UNO - BID MODEL
+ *
+ * Online frequency model of the number cards each seat plays, conditioned
+ * on the situation at the time of the bid: own hand size, own win streak
+ * and the hand size of the leading opponent (each bucketed). Memory is a
+ * fixed table of small counters per seat and situation; recording a bid
+ * and predicting a distribution each touch one table cell.
+ *
+ * Sparse situations are smoothed towards the seat's overall bid
+ * frequencies. Counters are halved when a cell fills up, so the model
+ * follows players who change their style during a long session.
+ *
+ * Every recorded bid is also kept as a BidChange holding the two cells it
+ * replaced, until the host collects them with takeChanges(); revert() and
+ * replay() use them to take bids back and apply them again exactly, for
+ * undo and redo.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_BID_MODEL_H
+#define SPLIT_UNO_BID_MODEL_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "game_state.h"
+#include "rules.h"
+
+// Hand-size buckets: 0-2, 3-5, 6-9, 10-14, 15-20, 21+
+constexpr int BID_HAND_BUCKETS = 6;
+constexpr int BID_STREAK_BUCKETS = 3;  // 0, 1, 2+
+constexpr int BID_SITUATIONS = BID_HAND_BUCKETS * BID_STREAK_BUCKETS * BID_HAND_BUCKETS;
+
+constexpr int BID_HAND_CAP = 21;  // Larger hands share the last bucket
+constexpr std::array<uint8_t, BID_HAND_CAP + 1> BID_HAND_BUCKET = {
+    0, 0, 0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 5,
+};
+
+class BidModel {
+    struct Cell {
+        std::array<uint16_t, NUM_CARD_VALUES> counts{};
+        uint16_t total = 0;
+    };
+
+public:
+    // One recorded bid and the counters it replaced
+    struct BidChange {
+        uint8_t seat;
+        uint8_t card;
+        uint16_t situation;
+        Cell cellBefore;
+        Cell overallBefore;
+    };
+
+    // Situation index of player's next bid in state s
+    static int situation(const GameState& s, int player) {
+        int leading = -1;
+        for (int i = 0; i < s.numPlayers; ++i) {
+            if (i != player && (leading < 0 || s.numberCards[i] < leading)) leading = s.numberCards[i];
+        }
+        int own = BID_HAND_BUCKET[std::min(s.numberCards[player], BID_HAND_CAP)];
+        int opp = BID_HAND_BUCKET[std::min(std::max(leading, 0), BID_HAND_CAP)];
+        int streak = std::min(s.consecutiveWins[player], BID_STREAK_BUCKETS - 1);
+        return (own * BID_STREAK_BUCKETS + streak) * BID_HAND_BUCKETS + opp;
+    }
+
+    // Records that player bid card in state s (before the round resolved).
+    void observe(const GameState& s, int player, int card) {
+        int at = situation(s, player);
+        changes.push_back({static_cast<uint8_t>(player), static_cast<uint8_t>(card), static_cast<uint16_t>(at),
+                           cells[player][at], overall[player]});
+        add(cells[player][at], card);
+        add(overall[player], card);
+    }
+
+    // Bids recorded since the last call, oldest first
+    std::vector<BidChange> takeChanges() { return std::exchange(changes, {}); }
+
+    // Takes back bids, newest first, leaving the counters as they were before
+    void revert(const BidChange* first, const BidChange* last) {
+        while (last != first) {
+            --last;
+            cells[last->seat][last->situation] = last->cellBefore;
+            overall[last->seat] = last->overallBefore;
+        }
+    }
+
+    // Applies reverted bids again, oldest first
+    void replay(const BidChange* first, const BidChange* last) {
+        for (; first != last; ++first) {
+            add(cells[first->seat][first->situation], first->card);
+            add(overall[first->seat], first->card);
+        }
+    }
+
+    // Probability of each card for player's next bid in state s
+    std::array<float, NUM_CARD_VALUES> predict(const GameState& s, int player) const {
+        const Cell& cell = cells[player][situation(s, player)];
+        const Cell& base = overall[player];
+        std::array<float, NUM_CARD_VALUES> p;
+        float baseScale = 1.0f / (static_cast<float>(base.total) + NUM_CARD_VALUES);  // Laplace-smoothed prior
+        float scale = 1.0f / (static_cast<float>(cell.total) + PRIOR_WEIGHT);
+        for (int c = 0; c < NUM_CARD_VALUES; ++c) {
+            float prior = (static_cast<float>(base.counts[c]) + 1.0f) * baseScale;
+            p[c] = (static_cast<float>(cell.counts[c]) + PRIOR_WEIGHT * prior) * scale;
+        }
+        return p;
+    }
+
+    // Bids recorded for player (after halving, a recent-weighted count)
+    uint32_t observations(int player) const { return overall[player].total; }
+
+    void clear() {
+        for (auto& seat : cells) seat.fill(Cell{});
+        overall.fill(Cell{});
+        changes.clear();
+    }
+
+private:
+    static constexpr float PRIOR_WEIGHT = 4.0f;   // Pseudo-bids drawn from the seat's overall mix
+    static constexpr uint16_t HALVE_AT = 4096;    // Cell total that triggers halving
+
+    std::array<std::array<Cell, BID_SITUATIONS>, MAX_PLAYERS> cells{};
+    std::array<Cell, MAX_PLAYERS> overall{};
+    std::vector<BidChange> changes;  // Not yet taken by the host
+
+    static void add(Cell& cell, int card) {
+        ++cell.counts[card];
+        if (++cell.total < HALVE_AT) return;
+        cell.total = 0;
+        for (auto& n : cell.counts) {
+            n = static_cast<uint16_t>((n + 1) / 2);
+            cell.total = static_cast<uint16_t>(cell.total + n);
+        }
+    }
+};
+
+#endif // SPLIT_UNO_BID_MODEL_H
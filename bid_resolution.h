@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * SPLIT UNO - BID RESOLUTION
+ *
+ * Resolves the bids of one number round: highest card, which seats played
+ * it, which seats played at all (blocked seats bid NO_CARD) and which seats
+ * lost to a single winner. Every simulated round goes through this, so it
+ * is branch-free and allocation-free: on x86-64 the six bids are packed
+ * into one SSE2 register, the maximum is found with three shuffles and the
+ * seat masks come out of compare + movemask. Elsewhere a scalar loop
+ * computes the same masks.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_BID_RESOLUTION_H
+#define SPLIT_UNO_BID_RESOLUTION_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define SPLIT_UNO_BIDS_SSE2 1
+#endif
+
+#include "game_state.h"
+
+struct BidResolution {
+    int maxCard;          // Highest card played, NO_CARD if every seat was blocked
+    int winner;           // The only seat that played maxCard, else NO_WINNER
+    uint8_t playedMask;   // Bit per seat that was not blocked
+    uint8_t topMask;      // Bit per seat that played maxCard
+    uint8_t loserMask;    // Seats that played and lost to winner; 0 on a tie
+};
+
+// Masks to outcome; shared by both kernels
+inline BidResolution finishResolution(int maxCard, uint32_t playedMask, uint32_t topMask) {
+    const uint32_t single = (topMask & (topMask - 1)) == 0 && topMask != 0;
+    const int lowest = __builtin_ctz(topMask | 0x80u);
+    return {maxCard, single ? lowest : NO_WINNER, static_cast<uint8_t>(playedMask), static_cast<uint8_t>(topMask),
+            static_cast<uint8_t>(playedMask & ~topMask & (0u - single))};
+}
+
+// Bids of seats [0, numPlayers); entries past numPlayers are ignored.
+inline BidResolution resolveBids(const std::array<int, MAX_PLAYERS>& played, int numPlayers) {
+#ifdef SPLIT_UNO_BIDS_SSE2
+    static_assert(MAX_PLAYERS == 6 && NO_CARD == -1, "bids are packed as six int16 lanes, NO_CARD = -1");
+    // Lanes 0-3 and 4-5 as int16, lanes 6-7 and unused seats set to NO_CARD
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(played.data()));
+    __m128i high = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(played.data() + 4));
+    __m128i bids = _mm_packs_epi32(low, high);
+    const __m128i seats = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+    __m128i seated = _mm_cmplt_epi16(seats, _mm_set1_epi16(static_cast<short>(numPlayers)));
+    bids = _mm_or_si128(_mm_and_si128(seated, bids), _mm_andnot_si128(seated, _mm_set1_epi16(NO_CARD)));
+
+    // Horizontal maximum, broadcast to every lane
+    __m128i top = _mm_max_epi16(bids, _mm_shuffle_epi32(bids, _MM_SHUFFLE(1, 0, 3, 2)));
+    top = _mm_max_epi16(top, _mm_shuffle_epi32(top, _MM_SHUFFLE(2, 3, 0, 1)));
+    top = _mm_max_epi16(top, _mm_shufflelo_epi16(_mm_shufflehi_epi16(top, _MM_SHUFFLE(2, 3, 0, 1)),
+                                                 _MM_SHUFFLE(2, 3, 0, 1)));
+
+    // Played: bid > NO_CARD; top: played and equal to the maximum
+    __m128i isPlayed = _mm_cmpgt_epi16(bids, _mm_set1_epi16(NO_CARD));
+    __m128i isTop = _mm_and_si128(_mm_cmpeq_epi16(bids, top), isPlayed);
+    uint32_t masks = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(isPlayed, isTop)));
+    return finishResolution(static_cast<int16_t>(_mm_cvtsi128_si32(top)), masks & 0xFF, masks >> 8);
+#else
+    int maxCard = NO_CARD;
+    for (int i = 0; i < numPlayers; ++i) maxCard = std::max(maxCard, played[i]);
+    uint32_t playedMask = 0, topMask = 0;
+    for (int i = 0; i < numPlayers; ++i) {
+        playedMask |= static_cast<uint32_t>(played[i] != NO_CARD) << i;
+        topMask |= static_cast<uint32_t>((played[i] != NO_CARD) & (played[i] == maxCard)) << i;
+    }
+    return finishResolution(maxCard, playedMask, topMask);
+#endif
+}
+
+#endif // SPLIT_UNO_BID_RESOLUTION_H
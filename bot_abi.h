@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * SPLIT UNO - BOT PLUGIN ABI
+ *
+ * C interface for bots compiled into shared libraries and loaded by the
+ * arbiter at runtime (--tournament, --bot). This header is plain C and has
+ * no dependency on the rest of the arbiter; plugin authors include only it.
+ *
+ * A plugin exports one function, split_uno_bot_api, returning a pointer to
+ * a static SuBotApi. Every callback receives the bot instance returned by
+ * create() and the game state as an SuState, laid out exactly like the
+ * arbiter's own state so it is passed without conversion. Callbacks left
+ * NULL fall back to the built-in greedy bot, and every invalid answer is
+ * replaced the same way: a card or choice out of range, an illegal target,
+ * an action that is not playable, or a BLOCK counter, +2/+4 counter,
+ * challenge or action played from an empty action hand. Passing (no
+ * counter, SU_NO_CHALLENGE, SU_ACTION_NONE) is always valid.
+ *
+ * Build a plugin with:
+ *   cc -std=c99 -O2 -shared -fPIC -o my_bot.so my_bot.c
+ *
+ * Compatibility: a plugin loads when its abiVersion equals
+ * SU_BOT_ABI_VERSION. Fields are only ever appended to SuBotApi, and the
+ * version is raised whenever an existing field or SuState changes.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_BOT_ABI_H
+#define SPLIT_UNO_BOT_ABI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SU_BOT_ABI_VERSION 1
+#define SU_BOT_ENTRY "split_uno_bot_api"
+
+#define SU_MAX_PLAYERS 6
+#define SU_NO_WINNER (-1)
+#define SU_NO_CHALLENGE (-1)
+
+/* Prompts passed to target(), answer() and choice() */
+enum {
+    SU_PROMPT_STEAL_TARGET,    /* Card 0: who to steal from */
+    SU_PROMPT_PENALTY_TARGET,  /* Card 7: who draws the penalty */
+    SU_PROMPT_BLOCK_TARGET,
+    SU_PROMPT_SWAP_TARGET,
+    SU_PROMPT_DRAW_TARGET,     /* +2/+4: who to attack */
+    SU_PROMPT_TRUTH_TARGET,
+    SU_PROMPT_DARE_TARGET,
+    SU_PROMPT_BLOCK_COUNTER,   /* Counter a BLOCK with a BLOCK? */
+    SU_PROMPT_TRUTH_ANSWER,    /* Did the target answer? */
+    SU_PROMPT_DARE_COMPLETE,   /* Did the target complete the dare? */
+    SU_PROMPT_BONUS_CHOICE,    /* 1 = draw action cards, 2 = opponents draw */
+    SU_PROMPT_TRUTH_PENALTY,   /* 1 = penalty A, 2 = penalty B */
+    SU_PROMPT_COLOR_CHOICE     /* 0-3 */
+};
+
+/* Actions; bit (1 << action) is set in the playable mask for each action
+   the variant allows. SU_ACTION_NONE passes. */
+enum {
+    SU_ACTION_BLOCK,
+    SU_ACTION_SKIP,
+    SU_ACTION_REVERSE,
+    SU_ACTION_COLOR_CHANGE,
+    SU_ACTION_WILD,
+    SU_ACTION_DRAW_TWO,
+    SU_ACTION_DRAW_FOUR,
+    SU_ACTION_TRUTH,
+    SU_ACTION_DARE,
+    SU_ACTION_NONE
+};
+
+/* Count-based game state, indexed by seat */
+typedef struct SuState {
+    int32_t numPlayers;
+    int32_t numberCards[SU_MAX_PLAYERS];
+    int32_t actionCards[SU_MAX_PLAYERS];
+    int32_t streak[SU_MAX_PLAYERS];    /* Consecutive round wins */
+    uint8_t blocked[SU_MAX_PLAYERS];   /* 1 = skips the next number round */
+    uint8_t reserved0[2];
+    int32_t numberDeck;                /* Cards left in the number deck */
+    int32_t actionDeck;
+    uint8_t gameOver;
+    uint8_t reserved1[3];
+    int32_t winner;                    /* Seat or SU_NO_WINNER */
+} SuState;
+
+typedef struct SuBotApi {
+    uint32_t abiVersion;  /* SU_BOT_ABI_VERSION */
+    const char* name;     /* Shown in tournament tables */
+
+    /* One instance per simulated game; both may be NULL for stateless bots */
+    void* (*create)(uint64_t seed);
+    void (*destroy)(void* bot);
+
+    /* Number card 0-9 for this round */
+    int (*bid)(void* bot, const SuState* s, int player);
+    /* Action card to play at the start of the player's turn, or SU_ACTION_NONE */
+    int (*action)(void* bot, const SuState* s, int player, uint32_t playable);
+    /* Seat other than player for a *_TARGET prompt */
+    int (*target)(void* bot, const SuState* s, int player, int prompt);
+    /* Nonzero = yes, for BLOCK_COUNTER, TRUTH_ANSWER and DARE_COMPLETE */
+    int (*answer)(void* bot, const SuState* s, int player, int prompt);
+    /* Numbered choice for BONUS_CHOICE, TRUTH_PENALTY and COLOR_CHOICE */
+    int (*choice)(void* bot, const SuState* s, int player, int prompt);
+    /* Counter a +amount aimed at target with 0 (none), 2 or 4 */
+    int (*drawCounter)(void* bot, const SuState* s, int target, int amount);
+    /* Seat challenging winner (down to 0 cards), or SU_NO_CHALLENGE */
+    int (*challenger)(void* bot, const SuState* s, int winner);
+    /* Card the challenger plays: 2 or 4 */
+    int (*challengeCard)(void* bot, const SuState* s, int challenger, int winner);
+} SuBotApi;
+
+typedef const SuBotApi* (*SuBotEntry)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPLIT_UNO_BOT_ABI_H */
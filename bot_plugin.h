@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * SPLIT UNO - BOT PLUGINS
+ *
+ * Loads bots built against bot_abi.h from shared libraries and adapts them
+ * to the controller interface of the rule engine. Calls go straight through
+ * the plugin's function pointers with the GameState reinterpreted as an
+ * SuState (the layouts are asserted equal below), so a plugin bot plays at
+ * the speed of a built-in one.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_BOT_PLUGIN_H
+#define SPLIT_UNO_BOT_PLUGIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#define SPLIT_UNO_PLUGINS 1
+#endif
+
+#include "action_table.h"
+#include "bot_abi.h"
+#include "bots.h"
+#include "engine.h"
+#include "game_state.h"
+
+static_assert(sizeof(SuState) == sizeof(GameState) && sizeof(bool) == 1 && sizeof(int) == 4,
+              "SuState must mirror GameState");
+static_assert(offsetof(SuState, numberCards) == offsetof(GameState, numberCards) &&
+              offsetof(SuState, actionCards) == offsetof(GameState, actionCards) &&
+              offsetof(SuState, streak) == offsetof(GameState, consecutiveWins) &&
+              offsetof(SuState, blocked) == offsetof(GameState, blocked) &&
+              offsetof(SuState, numberDeck) == offsetof(GameState, numberDeckRemaining) &&
+              offsetof(SuState, actionDeck) == offsetof(GameState, actionDeckRemaining) &&
+              offsetof(SuState, gameOver) == offsetof(GameState, gameOver) &&
+              offsetof(SuState, winner) == offsetof(GameState, winner),
+              "SuState must mirror GameState");
+static_assert(SU_MAX_PLAYERS == MAX_PLAYERS && SU_NO_WINNER == NO_WINNER && SU_NO_CHALLENGE == NO_CHALLENGE);
+static_assert(SU_PROMPT_STEAL_TARGET == static_cast<int>(Prompt::STEAL_TARGET) &&
+              SU_PROMPT_BLOCK_COUNTER == static_cast<int>(Prompt::BLOCK_COUNTER) &&
+              SU_PROMPT_BONUS_CHOICE == static_cast<int>(Prompt::BONUS_CHOICE) &&
+              SU_PROMPT_COLOR_CHOICE == static_cast<int>(Prompt::COLOR_CHOICE));
+static_assert(SU_ACTION_DARE == static_cast<int>(ActionType::DARE) &&
+              SU_ACTION_NONE == static_cast<int>(ActionType::UNKNOWN));
+
+// A loaded plugin library; stays loaded until destroyed.
+class BotPlugin {
+public:
+    BotPlugin() = default;
+    BotPlugin(const BotPlugin&) = delete;
+    BotPlugin& operator=(const BotPlugin&) = delete;
+    ~BotPlugin() { close(); }
+
+    bool open(const std::string& path, std::string& error) {
+        close();
+#ifdef SPLIT_UNO_PLUGINS
+        // dlopen searches the library path for bare names; plugins are files
+        std::string file = path.find('/') == std::string::npos ? "./" + path : path;
+        handle = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle) {
+            const char* why = dlerror();
+            error = "cannot load '" + path + "': " + (why ? why : "unknown error");
+            return false;
+        }
+        void* entry = dlsym(handle, SU_BOT_ENTRY);
+        const SuBotApi* table = entry ? reinterpret_cast<SuBotEntry>(entry)() : nullptr;
+        if (!table) {
+            error = "'" + path + "' does not export " SU_BOT_ENTRY;
+        } else if (table->abiVersion != SU_BOT_ABI_VERSION) {
+            error = "'" + path + "' was built for bot ABI version " + std::to_string(table->abiVersion) +
+                    ", expected " + std::to_string(SU_BOT_ABI_VERSION);
+        } else {
+            api = table;
+            label = table->name && *table->name ? table->name : path;
+            return true;
+        }
+        close();
+        return false;
+#else
+        error = "cannot load '" + path + "': bot plugins are not supported on this platform";
+        return false;
+#endif
+    }
+
+    const SuBotApi& functions() const { return *api; }
+    const std::string& name() const { return label; }
+
+private:
+    void* handle = nullptr;
+    const SuBotApi* api = nullptr;
+    std::string label;
+
+    void close() {
+#ifdef SPLIT_UNO_PLUGINS
+        if (handle) dlclose(handle);
+#endif
+        handle = nullptr;
+        api = nullptr;
+    }
+};
+
+/*******************************************************************************
+ * PLUGIN BOT
+ *
+ * Engine controller backed by a plugin. Answers are checked against the
+ * same limits the built-in bots respect; missing callbacks and invalid
+ * answers are handled by a GreedyBot, so a faulty plugin loses games
+ * instead of corrupting them.
+ ******************************************************************************/
+
+class PluginBot : public SilentController {
+public:
+    PluginBot(uint64_t seed, const BotPlugin& plugin)
+        : api(plugin.functions()), fallback(seed), self(api.create ? api.create(seed) : nullptr) {}
+    PluginBot(const PluginBot&) = delete;
+    PluginBot& operator=(const PluginBot&) = delete;
+    ~PluginBot() {
+        if (api.destroy) api.destroy(self);
+    }
+
+    int bid(const GameState& s, int player) {
+        int card = api.bid ? api.bid(self, view(s), player) : NO_CARD;
+        return card >= 0 && card < NUM_CARD_VALUES ? card : fallback.bid(s, player);
+    }
+    int target(const GameState& s, int player, Prompt prompt) {
+        int seat = api.target ? api.target(self, view(s), player, static_cast<int>(prompt)) : player;
+        return seat >= 0 && seat < s.numPlayers && seat != player ? seat : fallback.target(s, player, prompt);
+    }
+    bool answer(const GameState& s, int player, Prompt prompt) {
+        if (!api.answer) return fallback.answer(s, player, prompt);
+        bool yes = api.answer(self, view(s), player, static_cast<int>(prompt)) != 0;
+        bool valid = prompt != Prompt::BLOCK_COUNTER || !yes || s.actionCards[player] > 0;
+        return valid ? yes : fallback.answer(s, player, prompt);
+    }
+    int choice(const GameState& s, int player, Prompt prompt) {
+        int pick = api.choice ? api.choice(self, view(s), player, static_cast<int>(prompt)) : -1;
+        bool valid = prompt == Prompt::COLOR_CHOICE ? pick >= 0 && pick < 4 : pick == 1 || pick == 2;
+        return valid ? pick : fallback.choice(s, player, prompt);
+    }
+    int drawCounter(const GameState& s, int targetIdx, int amount) {
+        if (!api.drawCounter) return fallback.drawCounter(s, targetIdx, amount);
+        int card = api.drawCounter(self, view(s), targetIdx, amount);
+        bool valid = card == 0 || ((card == 2 || card == 4) && s.actionCards[targetIdx] > 0);
+        return valid ? card : fallback.drawCounter(s, targetIdx, amount);
+    }
+    int challenger(const GameState& s, int winnerIdx) {
+        if (!api.challenger) return fallback.challenger(s, winnerIdx);
+        int seat = api.challenger(self, view(s), winnerIdx);
+        bool valid = seat == NO_CHALLENGE ||
+                     (seat >= 0 && seat < s.numPlayers && seat != winnerIdx && s.actionCards[seat] > 0);
+        return valid ? seat : fallback.challenger(s, winnerIdx);
+    }
+    int challengeCard(const GameState& s, int challengerIdx, int winnerIdx) {
+        int card = api.challengeCard ? api.challengeCard(self, view(s), challengerIdx, winnerIdx) : 0;
+        return card == 2 || card == 4 ? card : fallback.challengeCard(s, challengerIdx, winnerIdx);
+    }
+    ActionType action(const GameState& s, int player, uint16_t playable) {
+        if (!api.action) return fallback.action(s, player, playable);
+        int type = api.action(self, view(s), player, playable);
+        if (type == SU_ACTION_NONE) return ActionType::UNKNOWN;
+        bool valid = type >= 0 && type < NUM_ACTION_TYPES && (playable & (1u << type)) && s.actionCards[player] > 0;
+        return valid ? static_cast<ActionType>(type) : fallback.action(s, player, playable);
+    }
+
+private:
+    const SuBotApi& api;
+    GreedyBot fallback;
+    void* self;
+
+    // Same bytes, C-compatible type
+    static const SuState* view(const GameState& s) { return reinterpret_cast<const SuState*>(&s); }
+};
+
+// Builds any bot from a seed; plugin bots also need their library.
+template <typename Bot>
+Bot makeBot(uint64_t seed, const BotPlugin* plugin) {
+    if constexpr (std::is_same_v<Bot, PluginBot>) {
+        return PluginBot(seed, *plugin);
+    } else {
+        (void)plugin;
+        return Bot(seed);
+    }
+}
+
+#endif // SPLIT_UNO_BOT_PLUGIN_H
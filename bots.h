@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * SPLIT UNO - BOTS
+ *
+ * Automated controllers for the rule engine (see engine.h), used by
+ * simulations. Bots decide from the count-based GameState only; whether a
+ * player actually holds a +2 or a BLOCK is unknown to the arbiter, so
+ * counters are modelled as "possible when holding any action card".
+ *
+ * Besides the engine prompts, bots answer one turn-level question:
+ *   ActionType action(const GameState&, int player, uint16_t playable)
+ * where playable has bit (1 << ActionType) set for every action the
+ * variant allows. Returning ActionType::UNKNOWN passes.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_BOTS_H
+#define SPLIT_UNO_BOTS_H
+
+#include <cstdint>
+#include <string>
+
+#include "action_table.h"
+#include "engine.h"
+#include "game_state.h"
+
+/*******************************************************************************
+ * RANDOM NUMBERS
+ ******************************************************************************/
+
+inline uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// xoshiro256** seeded through splitmix64
+class Rng {
+public:
+    explicit Rng(uint64_t seed = 1) {
+        for (auto& word : s) {
+            seed = splitMix64(seed);
+            word = seed;
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, n)
+    int below(int n) {
+        return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(n)) >> 32);
+    }
+
+    // True with probability percent / 100
+    bool chance(int percent) { return below(100) < percent; }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/*******************************************************************************
+ * BOT BASE
+ ******************************************************************************/
+
+// Silent controller plumbing shared by all bots
+class SilentController {
+public:
+    static constexpr bool NARRATES = false;
+
+    const std::string& name(int player) const {
+        static const std::string SEATS[MAX_PLAYERS] = {"P1", "P2", "P3", "P4", "P5", "P6"};
+        return SEATS[player];
+    }
+
+    template <typename... Args>
+    void say(const Args&...) {}
+};
+
+// Uniform random seat other than player
+inline int randomOpponent(Rng& rng, const GameState& s, int player) {
+    int pick = rng.below(s.numPlayers - 1);
+    return pick + (pick >= player);
+}
+
+// Opponent closest to winning (fewest number cards)
+inline int leadingOpponent(const GameState& s, int player) {
+    int best = player == 0 ? 1 : 0;
+    for (int i = 0; i < s.numPlayers; ++i) {
+        if (i != player && s.numberCards[i] < s.numberCards[best]) best = i;
+    }
+    return best;
+}
+
+// Uniform pick among the set bits of mask
+inline ActionType randomAction(Rng& rng, uint16_t mask) {
+    int count = __builtin_popcount(mask);
+    if (count == 0) return ActionType::UNKNOWN;
+    int pick = rng.below(count);
+    for (int t = 0; t < NUM_ACTION_TYPES; ++t) {
+        if (!(mask & (1u << t))) continue;
+        if (pick-- == 0) return static_cast<ActionType>(t);
+    }
+    return ActionType::UNKNOWN;
+}
+
+/*******************************************************************************
+ * RANDOM BOT
+ *
+ * Every decision uniformly at random among the legal options.
+ ******************************************************************************/
+
+class RandomBot : public SilentController {
+public:
+    explicit RandomBot(uint64_t seed) : rng(seed) {}
+
+    int bid(const GameState&, int) { return rng.below(NUM_CARD_VALUES); }
+    int target(const GameState& s, int player, Prompt) { return randomOpponent(rng, s, player); }
+    bool answer(const GameState& s, int player, Prompt prompt) {
+        if (prompt == Prompt::BLOCK_COUNTER) return s.actionCards[player] > 0 && rng.chance(50);
+        if (prompt == Prompt::DARE_COMPLETE) return true;  // Refusing forfeits the game
+        return rng.chance(50);
+    }
+    int choice(const GameState&, int, Prompt prompt) {
+        return prompt == Prompt::COLOR_CHOICE ? rng.below(4) : 1 + rng.below(2);
+    }
+    int drawCounter(const GameState& s, int targetIdx, int) {
+        if (s.actionCards[targetIdx] == 0 || rng.chance(50)) return 0;
+        return rng.chance(50) ? 2 : 4;
+    }
+    int challenger(const GameState& s, int winnerIdx) {
+        int who = randomOpponent(rng, s, winnerIdx);
+        return s.actionCards[who] > 0 && rng.chance(50) ? who : NO_CHALLENGE;
+    }
+    int challengeCard(const GameState&, int, int) { return rng.chance(50) ? 2 : 4; }
+
+    ActionType action(const GameState& s, int player, uint16_t playable) {
+        if (s.actionCards[player] == 0 || rng.chance(50)) return ActionType::UNKNOWN;
+        return randomAction(rng, playable);
+    }
+
+private:
+    Rng rng;
+};
+
+/*******************************************************************************
+ * GREEDY BOT
+ *
+ * Random bids, but every targeted effect goes at the opponent closest to
+ * winning, counters and challenges are always played when possible and the
+ * streak bonus always makes opponents draw.
+ ******************************************************************************/
+
+class GreedyBot : public SilentController {
+public:
+    explicit GreedyBot(uint64_t seed) : rng(seed) {}
+
+    int bid(const GameState&, int) { return rng.below(NUM_CARD_VALUES); }
+    int target(const GameState& s, int player, Prompt) { return leadingOpponent(s, player); }
+    bool answer(const GameState& s, int player, Prompt prompt) {
+        if (prompt == Prompt::BLOCK_COUNTER) return s.actionCards[player] > 0;
+        if (prompt == Prompt::DARE_COMPLETE) return true;
+        return rng.chance(50);
+    }
+    int choice(const GameState&, int, Prompt prompt) {
+        if (prompt == Prompt::COLOR_CHOICE) return rng.below(4);
+        if (prompt == Prompt::TRUTH_PENALTY) return 2;  // Target draws the most
+        return 2;                                        // Opponents draw
+    }
+    int drawCounter(const GameState& s, int targetIdx, int) { return s.actionCards[targetIdx] > 0 ? 4 : 0; }
+    int challenger(const GameState& s, int winnerIdx) {
+        int best = NO_CHALLENGE;
+        for (int i = 0; i < s.numPlayers; ++i) {
+            if (i == winnerIdx || s.actionCards[i] == 0) continue;
+            if (best == NO_CHALLENGE || s.actionCards[i] > s.actionCards[best]) best = i;
+        }
+        return best;
+    }
+    int challengeCard(const GameState&, int, int) { return 4; }
+
+    ActionType action(const GameState& s, int player, uint16_t playable) {
+        if (s.actionCards[player] == 0) return ActionType::UNKNOWN;
+        // REVERSE only pays off when our hand is the bigger one
+        if (s.numberCards[player] <= s.numberCards[leadingOpponent(s, player)]) {
+            playable &= static_cast<uint16_t>(~(1u << static_cast<int>(ActionType::REVERSE)));
+        }
+        return randomAction(rng, playable);
+    }
+
+private:
+    Rng rng;
+};
+
+#endif // SPLIT_UNO_BOTS_H
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * SPLIT UNO - CONSOLE OUTPUT
+ *
+ * Output stream for the interactive arbiter. Everything printed is
+ * collected in one preallocated buffer and handed to the terminal in a
+ * single write() when the stream is flushed, instead of one flush per line.
+ * The arbiter ties cin to this stream, so the buffer goes out exactly when
+ * the program is about to wait for input: one write per screen and prompt.
+ * A screen larger than the buffer is written in buffer-sized pieces.
+ *
+ * inputReady lets a prompt with a deadline wait for the operator without
+ * blocking in a read.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_CONSOLE_OUTPUT_H
+#define SPLIT_UNO_CONSOLE_OUTPUT_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+class ScreenBuffer : public std::streambuf {
+public:
+    explicit ScreenBuffer(size_t capacity) : storage(capacity) { setp(storage.data(), storage.data() + storage.size()); }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!emit()) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return emit() ? 0 : -1; }
+
+private:
+    std::vector<char> storage;
+
+    bool emit() {
+        const char* p = pbase();
+        size_t left = static_cast<size_t>(pptr() - pbase());
+        setp(storage.data(), storage.data() + storage.size());
+#if defined(__unix__) || defined(__APPLE__)
+        while (left > 0) {
+            ssize_t written = ::write(STDOUT_FILENO, p, left);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += written;
+            left -= static_cast<size_t>(written);
+        }
+        return true;
+#else
+        return std::fwrite(p, 1, left, stdout) == left && std::fflush(stdout) == 0;
+#endif
+    }
+};
+
+// std::ostream over a ScreenBuffer; flushes what is left when destroyed.
+class ConsoleOutput : public std::ostream {
+public:
+    explicit ConsoleOutput(size_t capacity = 1 << 16) : std::ostream(nullptr), buffer(capacity) { rdbuf(&buffer); }
+    ~ConsoleOutput() override { flush(); }
+
+private:
+    ScreenBuffer buffer;
+};
+
+// Waits up to timeoutMs for standard input to become readable (or reach end
+// of file). Where that cannot be polled it reports input as ready at once,
+// so the caller's read simply blocks.
+inline bool inputReady(int timeoutMs) {
+#if defined(__unix__) || defined(__APPLE__)
+    pollfd input{STDIN_FILENO, POLLIN, 0};
+    int ready = ::poll(&input, 1, timeoutMs);
+    return ready != 0;  // Errors count as ready so the read reports them
+#else
+    (void)timeoutMs;
+    return true;
+#endif
+}
+
+#endif // SPLIT_UNO_CONSOLE_OUTPUT_H
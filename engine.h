@@ -0,0 +1,531 @@
+/*******************************************************************************
+ * SPLIT UNO - RULE ENGINE
+ *
+ * The rule logic of the arbiter, independent of where decisions come from.
+ * RuleEngine is a template over the rule variant and a Controller that
+ * answers every prompt and receives the narration:
+ *
+ *   int  bid(const GameState&, int player)                       card 0-9
+ *   int  target(const GameState&, int player, Prompt)            seat != player
+ *   bool answer(const GameState&, int player, Prompt)            yes/no prompts
+ *   int  choice(const GameState&, int player, Prompt)            numbered menus
+ *   int  drawCounter(const GameState&, int target, int amount)   0, 2 or 4
+ *   int  challenger(const GameState&, int winner)                seat or NO_CHALLENGE
+ *   int  challengeCard(const GameState&, int challenger, int winner)  2 or 4
+ *   const std::string& name(int player)
+ *   void say(const Args&...)                                     one line of narration
+ *   static constexpr bool NARRATES                               false skips building messages
+ *
+ * The console arbiter prompts the operator; simulations plug in bots whose
+ * say() is empty, so narration compiles away.
+ *
+ * Any further template arguments are observers that receive every rule
+ * outcome as it happens (see rule_events.h).
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_ENGINE_H
+#define SPLIT_UNO_ENGINE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "action_table.h"
+#include "bid_model.h"
+#include "bid_resolution.h"
+#include "game_state.h"
+#include "round_log.h"
+#include "rule_events.h"
+#include "rules.h"
+
+// Decisions the engine asks its controller for
+enum class Prompt : uint8_t {
+    // Targets
+    STEAL_TARGET,    // Card 0: who to steal from
+    PENALTY_TARGET,  // Card 7: who draws the penalty
+    BLOCK_TARGET,
+    SWAP_TARGET,
+    DRAW_TARGET,     // +2/+4: who to attack
+    TRUTH_TARGET,
+    DARE_TARGET,
+    // Yes/no answers (asked of the target)
+    BLOCK_COUNTER,   // Did the target counter with a BLOCK?
+    TRUTH_ANSWER,    // Did the target answer?
+    DARE_COMPLETE,   // Did the target complete the dare?
+    // Numbered choices
+    BONUS_CHOICE,    // 1 = draw action cards, 2 = opponents draw
+    TRUTH_PENALTY,   // 1 = penalty A, 2 = penalty B
+    COLOR_CHOICE,    // 0-3 = Color
+};
+
+constexpr int NO_CHALLENGE = -1;
+
+// Card colors
+enum class Color {
+    RED, YELLOW, GREEN, BLUE, WILD
+};
+
+constexpr const char* COLOR_NAMES[] = {"RED", "YELLOW", "GREEN", "BLUE", "WILD"};
+
+template <typename Rules, typename Controller, typename... Observers>
+class RuleEngine {
+public:
+    RuleEngine(const RuleTables& rules, Controller& controller, Observers&... observers)
+        : tables(rules), ctl(controller), events(observers...) {
+        state.reset(tables, MIN_PLAYERS);
+    }
+
+    void newGame(int numPlayers) {
+        state.reset(tables, numPlayers);
+        roundNumber = 0;
+    }
+
+    // Continues a saved game from its state and round count.
+    void restore(const GameState& saved, uint32_t rounds) {
+        state = saved;
+        roundNumber = rounds;
+    }
+
+    GameState& gameState() { return state; }
+    const GameState& gameState() const { return state; }
+    const RuleTables& rules() const { return tables; }
+    uint32_t roundsPlayed() const { return roundNumber; }
+
+    // Records every number round to log (may be null) under the given game id.
+    void attachRoundLog(RoundLogWriter* log, uint32_t gameId) {
+        roundLog = log;
+        logGameId = gameId;
+    }
+
+    // Feeds every bid to model (may be null) as it is entered.
+    void attachBidModel(BidModel* model) { bidModel = model; }
+
+    // True if this variant has a handler for the action.
+    static constexpr bool isPlayable(ActionType type) {
+        return type != ActionType::UNKNOWN && ACTION_HANDLERS[static_cast<int>(type)] != nullptr;
+    }
+
+    /***************************************************************************
+     * NUMBER CARD ROUND HANDLERS
+     ***************************************************************************/
+
+    void handleNumberRound() {
+        const int n = state.numPlayers;
+        std::array<int, MAX_PLAYERS> playedCards;
+        playedCards.fill(NO_CARD);
+
+        // 1. Collect cards from all non-blocked players
+        for (int i = 0; i < n; ++i) {
+            if (state.blocked[i]) {
+                ctl.say(">>> ", ctl.name(i), " is BLOCKED and skips this round.");
+                continue;
+            }
+            playedCards[i] = ctl.bid(state, i);
+            if (bidModel) bidModel->observe(state, i, playedCards[i]);
+        }
+        // Blocks only last for one round
+        state.blocked.fill(0);
+
+        // Highest card, the seats that played it and the seats that lost
+        const BidResolution bids = resolveBids(playedCards, n);
+        const int maxCard = bids.maxCard;
+
+        // 2. Process Special Effects (0 and 7)
+        std::array<int, MAX_PLAYERS> stealTargets;
+        std::array<int, MAX_PLAYERS> penaltyTargets;
+        stealTargets.fill(-1);
+        penaltyTargets.fill(-1);
+        for (int i = 0; i < n; ++i) {
+            if (playedCards[i] == NO_CARD) continue;
+            int steal = tables.bidSteal[playedCards[i]];
+            if (steal > 0) {
+                ctl.say("\n>>> ", ctl.name(i), " played ", playedCards[i], "! Steal ", steal, " card(s).");
+                int targetIdx = ctl.target(state, i, Prompt::STEAL_TARGET);
+                stealTargets[i] = targetIdx;
+                int stolen = std::min(steal, state.numberCards[targetIdx]);
+                if (stolen > 0) {
+                    state.numberCards[i] += stolen;
+                    state.numberCards[targetIdx] -= stolen;
+                    ctl.say(">>> Stolen ", stolen, " card(s) from ", ctl.name(targetIdx), ".");
+                } else {
+                    ctl.say(">>> Target has no cards to steal!");
+                }
+                events.notify(CardsStolen{i, targetIdx, stolen}, state);
+            }
+            int penaltyNumber = tables.bidPenaltyNumber[playedCards[i]];
+            int penaltyAction = tables.bidPenaltyAction[playedCards[i]];
+            if (penaltyNumber + penaltyAction > 0) {
+                ctl.say("\n>>> ", ctl.name(i), " played ", playedCards[i], "! Target draws penalty.");
+                int targetIdx = ctl.target(state, i, Prompt::PENALTY_TARGET);
+                penaltyTargets[i] = targetIdx;
+                int numDrawn = drawFromNumberDeck(penaltyNumber);
+                int actDrawn = drawFromActionDeck(penaltyAction);
+                state.numberCards[targetIdx] += numDrawn;
+                state.actionCards[targetIdx] += actDrawn;
+                ctl.say(">>> ", ctl.name(targetIdx), " draws ", numDrawn, " Num and ", actDrawn, " Act cards.");
+                events.notify(PenaltyDrawn{i, targetIdx, numDrawn, actDrawn}, state);
+            }
+        }
+
+        // 3. Resolve Winner
+        if (bids.topMask == 0) {
+            ctl.say(">>> All players were blocked! No winner.");
+            recordRound(playedCards, stealTargets, penaltyTargets, 0, NO_WINNER);
+            return;
+        }
+
+        const int winnerIdx = bids.winner;
+        if (winnerIdx != NO_WINNER) {
+            ctl.say("\n>>> ", ctl.name(winnerIdx), " WINS the round with ", maxCard, "!");
+
+            // Winner sheds their card
+            state.numberCards[winnerIdx] = std::max(0, state.numberCards[winnerIdx] - tables.winnerShed);
+            state.consecutiveWins[winnerIdx]++;
+
+            // Reset others' consecutive wins and make them draw penalty
+            for (int i = 0; i < n; ++i) state.consecutiveWins[i] *= 1 - (bids.loserMask >> i & 1);
+            for (uint32_t losers = bids.loserMask; losers; losers &= losers - 1) {
+                state.numberCards[__builtin_ctz(losers)] += drawFromNumberDeck(tables.loserDraw);
+            }
+            events.notify(RoundWon{winnerIdx, maxCard}, state);
+        } else {
+            if constexpr (Controller::NARRATES) {
+                std::string tied;
+                for (int i = 0; i < n; ++i) {
+                    if (!(bids.topMask >> i & 1)) continue;
+                    if (!tied.empty()) tied += ", ";
+                    tied += ctl.name(i);
+                }
+                ctl.say("\n>>> TIE between ", tied, "!");
+            }
+
+            // Tied players shed their cards; reset consecutive on tie unless house rules keep it
+            for (int i = 0; i < n; ++i) {
+                const int tied = bids.topMask >> i & 1;
+                state.numberCards[i] = std::max(0, state.numberCards[i] - tables.tieShed * tied);
+                state.consecutiveWins[i] *= 1 - tied * (1 - tables.tieStreakKeep);
+            }
+            ctl.say(">>> Tied players shed ", tables.tieShed, " card(s). All players draw ",
+                    tables.tieDraw, " card(s).");  // House rule for ties
+
+            for (int i = 0; i < n; ++i) {
+                state.numberCards[i] += drawFromNumberDeck(tables.tieDraw);
+            }
+            events.notify(RoundTied{maxCard, bids.topMask}, state);
+        }
+
+        recordRound(playedCards, stealTargets, penaltyTargets, bids.topMask, winnerIdx);
+        checkConsecutiveWins();
+        checkWinCondition();
+    }
+
+    /***************************************************************************
+     * ACTION CARD HANDLERS
+     ***************************************************************************/
+
+    // Runs the handler for an action card typed at the terminal.
+    void dispatchAction(int playerIdx, ActionType type) {
+        if (!isPlayable(type)) {
+            ctl.say(">>> Error: Unknown action type.");
+            return;
+        }
+        (this->*ACTION_HANDLERS[static_cast<int>(type)])(playerIdx);
+    }
+
+    void handleBlockCard(int playerIdx) {
+        ctl.say("\n>>> ", ctl.name(playerIdx), " plays BLOCK!");
+        int targetIdx = ctl.target(state, playerIdx, Prompt::BLOCK_TARGET);
+
+        bool countered = ctl.answer(state, targetIdx, Prompt::BLOCK_COUNTER);
+        if (countered) {
+            ctl.say(">>> Countered! Both shed 1 Number Card.");
+            state.numberCards[playerIdx] = std::max(0, state.numberCards[playerIdx] - 1);
+            state.numberCards[targetIdx] = std::max(0, state.numberCards[targetIdx] - 1);
+            state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+            state.actionCards[targetIdx] = std::max(0, state.actionCards[targetIdx] - 1);
+        } else {
+            ctl.say(">>> ", ctl.name(targetIdx), " is BLOCKED for next round!");
+            state.blocked[targetIdx] = 1;
+            state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+        }
+        events.notify(BlockPlayed{playerIdx, targetIdx, countered}, state);
+    }
+
+    void handleReverseCard(int playerIdx) {
+        ctl.say("\n>>> ", ctl.name(playerIdx), " plays REVERSE (Swap Hands)!");
+        int targetIdx = ctl.target(state, playerIdx, Prompt::SWAP_TARGET);
+
+        ctl.say(">>> Swapping hands between ", ctl.name(playerIdx), " and ", ctl.name(targetIdx), "!");
+
+        std::swap(state.numberCards[playerIdx], state.numberCards[targetIdx]);
+        std::swap(state.actionCards[playerIdx], state.actionCards[targetIdx]);
+        // The player sheds the action card from their new hand (ruleset step 4)
+        state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+        events.notify(HandsSwapped{playerIdx, targetIdx}, state);
+    }
+
+    void handleColorChangeCard(int playerIdx) {
+        ctl.say("\n>>> ", ctl.name(playerIdx), " plays COLOR CHANGE!");
+        ctl.say(">>> All players shed 1 Number Card.");
+
+        for (int i = 0; i < state.numPlayers; ++i) {
+            state.numberCards[i] = std::max(0, state.numberCards[i] - 1);
+        }
+
+        int color = ctl.choice(state, playerIdx, Prompt::COLOR_CHOICE);
+        ctl.say(">>> Next player must play ", COLOR_NAMES[color], ".");
+        state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+        events.notify(ColorChanged{playerIdx, color}, state);
+    }
+
+    void handleDrawCard(int playerIdx, int amount) {
+        ctl.say("\n>>> ", ctl.name(playerIdx), " plays +", amount, "!");
+        int targetIdx = ctl.target(state, playerIdx, Prompt::DRAW_TARGET);
+
+        if constexpr (!Rules::COUNTERS_ENABLED) {
+            ctl.say(">>> ", ctl.name(targetIdx), " takes the hit! Draws ", amount, ".");
+            int drawn = drawFromNumberDeck(amount);
+            state.numberCards[targetIdx] += drawn;
+            state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+            events.notify(DrawAttack{playerIdx, targetIdx, amount, 0, targetIdx, drawn}, state);
+            return;
+        }
+
+        // Check for counter
+        int oppAmount = ctl.drawCounter(state, targetIdx, amount);
+
+        if (oppAmount > 0) {
+            int diff = std::abs(amount - oppAmount);
+            int loserDraw = 1 + diff;
+
+            int loser = NO_WINNER;
+            int drawn = 0;
+            if (amount > oppAmount) {
+                ctl.say(">>> ", ctl.name(playerIdx), " wins counter! ", ctl.name(targetIdx),
+                        " draws ", loserDraw, ".");
+                loser = targetIdx;
+                drawn = drawFromNumberDeck(loserDraw);
+                state.numberCards[targetIdx] += drawn;
+            } else if (oppAmount > amount) {
+                ctl.say(">>> ", ctl.name(targetIdx), " wins counter! ", ctl.name(playerIdx),
+                        " draws ", loserDraw, ".");
+                loser = playerIdx;
+                drawn = drawFromNumberDeck(loserDraw);
+                state.numberCards[playerIdx] += drawn;
+            } else {
+                ctl.say(">>> Tie! Both shed action card and draw 1 Number Card.");
+                state.numberCards[playerIdx] += drawFromNumberDeck(1);
+                state.numberCards[targetIdx] += drawFromNumberDeck(1);
+            }
+            // Both shed their action cards
+            state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+            state.actionCards[targetIdx] = std::max(0, state.actionCards[targetIdx] - 1);
+            events.notify(DrawAttack{playerIdx, targetIdx, amount, oppAmount, loser, drawn}, state);
+        } else {
+            ctl.say(">>> ", ctl.name(targetIdx), " takes the hit! Draws ", amount, ".");
+            int drawn = drawFromNumberDeck(amount);
+            state.numberCards[targetIdx] += drawn;
+            state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+            events.notify(DrawAttack{playerIdx, targetIdx, amount, 0, targetIdx, drawn}, state);
+        }
+    }
+
+    void handleDrawTwoCard(int playerIdx) { handleDrawCard(playerIdx, 2); }
+    void handleDrawFourCard(int playerIdx) { handleDrawCard(playerIdx, 4); }
+
+    void handleTruthCard(int playerIdx) {
+        ctl.say("\n>>> ", ctl.name(playerIdx), " plays TRUTH!");
+        int targetIdx = ctl.target(state, playerIdx, Prompt::TRUTH_TARGET);
+
+        bool answered = ctl.answer(state, targetIdx, Prompt::TRUTH_ANSWER);
+        int choice = 0;
+        if (!answered) {
+            choice = ctl.choice(state, playerIdx, Prompt::TRUTH_PENALTY);
+            state.actionCards[playerIdx] += drawFromActionDeck(tables.truthAttackerAction[choice]);
+            state.numberCards[targetIdx] += drawFromNumberDeck(tables.truthTargetNumber[choice]);
+        }
+
+        state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+        state.numberCards[playerIdx] = std::max(0, state.numberCards[playerIdx] - 1);
+        events.notify(TruthResolved{playerIdx, targetIdx, answered, choice}, state);
+    }
+
+    void handleDareCard(int playerIdx) {
+        ctl.say("\n>>> ", ctl.name(playerIdx), " plays DARE!");
+        int targetIdx = ctl.target(state, playerIdx, Prompt::DARE_TARGET);
+
+        bool completed = ctl.answer(state, targetIdx, Prompt::DARE_COMPLETE);
+        if (!completed) {
+            ctl.say(">>> ", ctl.name(targetIdx), " FORFEITS! ", ctl.name(playerIdx), " WINS!");
+            state.gameOver = true;
+            state.winner = playerIdx;
+        } else {
+            state.actionCards[playerIdx] = std::max(0, state.actionCards[playerIdx] - 1);
+            state.numberCards[playerIdx] = std::max(0, state.numberCards[playerIdx] - 1);
+        }
+        events.notify(DareResolved{playerIdx, targetIdx, completed}, state);
+    }
+
+    /***************************************************************************
+     * STREAK BONUS AND CHALLENGE HANDLERS
+     *
+     * Run by the number round; public so the advisor can play out one
+     * bonus or challenge on its own.
+     ***************************************************************************/
+
+    void handleStreakBonus(int p) {
+        ctl.say("\n>>> ", ctl.name(p), " has ", tables.consecutiveWinsThreshold, " consecutive wins!");
+        int choice = ctl.choice(state, p, Prompt::BONUS_CHOICE);
+
+        if (choice == 1) {
+            state.actionCards[p] += drawFromActionDeck(tables.bonusActionDraw);
+        } else {
+            for (int opp = 0; opp < state.numPlayers; ++opp) {
+                if (opp != p) {
+                    state.numberCards[opp] += drawFromNumberDeck(tables.bonusOpponentDraw);
+                }
+            }
+        }
+        state.consecutiveWins[p] = 0;
+        events.notify(BonusTaken{p, choice}, state);
+    }
+
+    void handleDrawChallenge(int winnerIdx) {
+        if constexpr (!Rules::CHALLENGES_ENABLED) {
+            ctl.say("\n>>> ", ctl.name(winnerIdx), " has 0 cards! No challenges in ", Rules::NAME, " mode.");
+            state.gameOver = true;
+            state.winner = winnerIdx;
+            events.notify(ChallengeResolved{winnerIdx, NO_CHALLENGE, 0}, state);
+            return;
+        }
+
+        // Check if any other player wants to challenge
+        ctl.say("\n>>> ", ctl.name(winnerIdx), " has 0 cards! Checking for challenges...");
+
+        int challengerIdx = ctl.challenger(state, winnerIdx);
+        if (challengerIdx == NO_CHALLENGE) {
+            state.gameOver = true;
+            state.winner = winnerIdx;
+            events.notify(ChallengeResolved{winnerIdx, NO_CHALLENGE, 0}, state);
+            return;
+        }
+
+        // Logic: Challenger plays +2/+4. Winner must draw unless they have counter?
+        // Simplified: If valid challenge, winner draws.
+        int amount = ctl.challengeCard(state, challengerIdx, winnerIdx);
+
+        ctl.say(">>> Challenge accepted! ", ctl.name(winnerIdx), " draws ", amount, ".");
+        state.numberCards[winnerIdx] += drawFromNumberDeck(amount);
+        state.actionCards[challengerIdx] = std::max(0, state.actionCards[challengerIdx] - 1);
+        events.notify(ChallengeResolved{winnerIdx, challengerIdx, amount}, state);
+    }
+
+private:
+    const RuleTables tables;
+    Controller& ctl;
+    GameState state;
+    RuleObservers<Observers...> events;
+
+    // Optional columnar export of every number round
+    RoundLogWriter* roundLog = nullptr;
+    uint32_t logGameId = 0;
+    uint32_t roundNumber = 0;
+
+    // Optional opponent bid model
+    BidModel* bidModel = nullptr;
+
+    // Handlers indexed by ActionType; null entries are not playable in this variant
+    using ActionHandler = void (RuleEngine::*)(int);
+    static constexpr ActionHandler ACTION_HANDLERS[NUM_ACTION_TYPES] = {
+        &RuleEngine::handleBlockCard,        // BLOCK
+        &RuleEngine::handleBlockCard,        // SKIP
+        &RuleEngine::handleReverseCard,      // REVERSE
+        &RuleEngine::handleColorChangeCard,  // COLOR_CHANGE
+        &RuleEngine::handleColorChangeCard,  // WILD
+        &RuleEngine::handleDrawTwoCard,      // DRAW_TWO
+        &RuleEngine::handleDrawFourCard,     // DRAW_FOUR
+        Rules::TRUTH_DARE_ENABLED ? &RuleEngine::handleTruthCard : nullptr,  // TRUTH
+        Rules::TRUTH_DARE_ENABLED ? &RuleEngine::handleDareCard : nullptr,   // DARE
+    };
+
+    int drawFromNumberDeck(int amount) {
+        if (amount <= 0) return 0;
+        if (state.numberDeckRemaining <= 0) {
+            ctl.say(">>> WARNING: Number deck is exhausted! No cards drawn.");
+            return 0;
+        }
+        int actualDraw = std::min(amount, state.numberDeckRemaining);
+        state.numberDeckRemaining -= actualDraw;
+        return actualDraw;
+    }
+
+    int drawFromActionDeck(int amount) {
+        if (amount <= 0) return 0;
+        if (state.actionDeckRemaining <= 0) {
+            ctl.say(">>> WARNING: Action deck is exhausted! No cards drawn.");
+            return 0;
+        }
+        int actualDraw = std::min(amount, state.actionDeckRemaining);
+        state.actionDeckRemaining -= actualDraw;
+        return actualDraw;
+    }
+
+    void recordRound(const std::array<int, MAX_PLAYERS>& playedCards,
+                     const std::array<int, MAX_PLAYERS>& stealTargets,
+                     const std::array<int, MAX_PLAYERS>& penaltyTargets,
+                     uint8_t topMask, int winnerIdx) {
+        ++roundNumber;
+        if (!roundLog) return;
+
+        RoundRecord r{};
+        r.game = logGameId;
+        r.round = roundNumber;
+        r.winner = static_cast<int8_t>(winnerIdx);
+        for (int i = 0; i < state.numPlayers; ++i) {
+            r.bid[i] = static_cast<int8_t>(playedCards[i]);
+            r.stealTarget[i] = static_cast<int8_t>(stealTargets[i]);
+            r.penaltyTarget[i] = static_cast<int8_t>(penaltyTargets[i]);
+            r.numberCards[i] = static_cast<int16_t>(state.numberCards[i]);
+            r.actionCards[i] = static_cast<int16_t>(state.actionCards[i]);
+            r.streak[i] = static_cast<uint8_t>(state.consecutiveWins[i]);
+            r.blocked[i] = playedCards[i] == NO_CARD;
+        }
+        r.tieMask = winnerIdx == NO_WINNER ? topMask : 0;
+        r.numberDeck = static_cast<int16_t>(state.numberDeckRemaining);
+        r.actionDeck = static_cast<int16_t>(state.actionDeckRemaining);
+        roundLog->record(r);
+    }
+
+    /***************************************************************************
+     * GAME FLOW LOGIC
+     ***************************************************************************/
+
+    void checkConsecutiveWins() {
+        const int n = state.numPlayers;
+        std::array<int, MAX_PLAYERS> earned;
+        int anyEarned = 0;
+        for (int i = 0; i < n; ++i) {
+            earned[i] = state.consecutiveWins[i] >= tables.consecutiveWinsThreshold;
+            anyEarned |= earned[i];
+        }
+        if (!anyEarned) return;
+
+        for (int p = 0; p < n; ++p) {
+            if (earned[p]) handleStreakBonus(p);
+        }
+    }
+
+    void checkWinCondition() {
+        for (int i = 0; i < state.numPlayers; ++i) {
+            if (state.numberCards[i] == 0) {
+                handleDrawChallenge(i);
+                if (state.gameOver) return;
+            }
+        }
+    }
+};
+
+#endif // SPLIT_UNO_ENGINE_H
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * SPLIT UNO - EXAMPLE BOT PLUGIN
+ *
+ * A complete plugin for bot_abi.h. It bids high, saves its action cards
+ * for opponents who are about to win, and leaves challenges to the
+ * arbiter's built-in fallback by not providing those callbacks.
+ *
+ * Build and enter it in a tournament:
+ *   make example-bot
+ *   ./split_uno_arbiter --tournament greedy,random,./example_bot.so
+ ******************************************************************************/
+
+#include <stdlib.h>
+
+#include "bot_abi.h"
+
+typedef struct ExampleBot {
+    uint64_t rng;
+} ExampleBot;
+
+static uint32_t nextRandom(ExampleBot* bot, uint32_t n) {
+    bot->rng ^= bot->rng << 13;
+    bot->rng ^= bot->rng >> 7;
+    bot->rng ^= bot->rng << 17;
+    return (uint32_t)((bot->rng >> 32) % n);
+}
+
+static int leader(const SuState* s, int player) {
+    int best = -1;
+    for (int i = 0; i < s->numPlayers; ++i) {
+        if (i != player && (best < 0 || s->numberCards[i] < s->numberCards[best])) best = i;
+    }
+    return best;
+}
+
+static void* create(uint64_t seed) {
+    ExampleBot* bot = malloc(sizeof *bot);
+    if (bot) bot->rng = seed | 1;
+    return bot;
+}
+
+static void destroy(void* bot) { free(bot); }
+
+static int bid(void* self, const SuState* s, int player) {
+    (void)s;
+    (void)player;
+    return 6 + (int)nextRandom(self, 4);  /* 6-9 */
+}
+
+static int action(void* self, const SuState* s, int player, uint32_t playable) {
+    (void)self;
+    int opp = leader(s, player);
+    if (s->actionCards[player] == 0 || s->numberCards[opp] > 5) return SU_ACTION_NONE;
+    if (playable & (1u << SU_ACTION_DRAW_FOUR)) return SU_ACTION_DRAW_FOUR;
+    if (playable & (1u << SU_ACTION_DRAW_TWO)) return SU_ACTION_DRAW_TWO;
+    if (playable & (1u << SU_ACTION_BLOCK)) return SU_ACTION_BLOCK;
+    return SU_ACTION_NONE;
+}
+
+static int target(void* self, const SuState* s, int player, int prompt) {
+    (void)self;
+    (void)prompt;
+    return leader(s, player);
+}
+
+static int answer(void* self, const SuState* s, int player, int prompt) {
+    (void)self;
+    if (prompt == SU_PROMPT_BLOCK_COUNTER) return s->actionCards[player] > 0;
+    return 1;
+}
+
+static int choice(void* self, const SuState* s, int player, int prompt) {
+    (void)player;
+    if (prompt == SU_PROMPT_COLOR_CHOICE) return (int)nextRandom(self, 4);
+    if (prompt == SU_PROMPT_BONUS_CHOICE) return s->actionDeck > 0 ? 1 : 2;  /* Stock up first */
+    return 2;
+}
+
+static int drawCounter(void* self, const SuState* s, int targetSeat, int amount) {
+    (void)self;
+    (void)amount;
+    return s->actionCards[targetSeat] > 0 ? 4 : 0;
+}
+
+static const SuBotApi API = {
+    SU_BOT_ABI_VERSION,
+    "example",
+    create,
+    destroy,
+    bid,
+    action,
+    target,
+    answer,
+    choice,
+    drawCounter,
+    NULL,  /* challenger: built-in fallback */
+    NULL,  /* challengeCard */
+};
+
+__attribute__((visibility("default"))) const SuBotApi* split_uno_bot_api(void) {
+    return &API;
+}
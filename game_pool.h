@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * SPLIT UNO - GAME POOL
+ *
+ * Storage for a host that keeps many games resident at once. Games live in
+ * fixed-size slots carved out of large pages (SLOTS_PER_PAGE slots per
+ * allocation), and a released slot goes on a free list that the next
+ * created game takes from, so creating and ending a game is a list pop or
+ * push and never touches the heap once the pool has grown to its working
+ * size. A bitmap marks the live slots; forEach walks the pages in order and
+ * skips free slots a 64-bit word at a time.
+ *
+ * Player names are interned in one NamePool shared by every game: each
+ * distinct name is stored once in large character blocks and a slot keeps
+ * only 32-bit name ids, so a slot is a small fixed-size value with no
+ * pointers of its own. Names are counted per seat that uses them; releasing
+ * the last game with a name frees its id and its bytes for the next new
+ * name, so name storage is bounded by the games live at once, like slots.
+ *
+ * Handles carry the slot's generation, which changes on every release, so
+ * a handle to an ended game is detected instead of reaching whichever game
+ * reuses the slot.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_GAME_POOL_H
+#define SPLIT_UNO_GAME_POOL_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "game_state.h"
+#include "rules.h"
+
+/*******************************************************************************
+ * NAME POOL
+ ******************************************************************************/
+
+class NamePool {
+public:
+    static constexpr size_t BLOCK_BYTES = 1 << 16;
+    static constexpr size_t MAX_NAME_BYTES = 255;  // As in saved games
+
+    // Id of name, counting one more use and adding it on first use; longer
+    // names are truncated.
+    uint32_t intern(std::string_view name) {
+        name = name.substr(0, MAX_NAME_BYTES);
+        auto found = index.find(name);
+        if (found != index.end()) {
+            ++entries[found->second].uses;
+            return found->second;
+        }
+
+        int sizeClass = classOf(name.size());
+        char* at = takeChunk(sizeClass);
+        std::memcpy(at, name.data(), name.size());
+
+        uint32_t id;
+        if (freeIds.empty()) {
+            id = static_cast<uint32_t>(entries.size());
+            entries.emplace_back();
+        } else {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        entries[id] = {std::string_view(at, name.size()), 1, static_cast<uint8_t>(sizeClass)};
+        index.emplace(entries[id].text, id);
+        return id;
+    }
+
+    // Drops one use of id; the last one frees the name, its id and its bytes.
+    void release(uint32_t id) {
+        Entry& e = entries[id];
+        if (--e.uses > 0) return;
+        index.erase(e.text);
+        spare[e.sizeClass].push_back(const_cast<char*>(e.text.data()));
+        e.text = {};
+        freeIds.push_back(id);
+    }
+
+    std::string_view name(uint32_t id) const { return entries[id].text; }
+    size_t size() const { return entries.size() - freeIds.size(); }
+    size_t bytesReserved() const { return blocks.size() * BLOCK_BYTES; }
+
+private:
+    // Names are stored in power-of-two chunks from MIN_CHUNK bytes up, so a
+    // freed chunk fits any later name of the same class.
+    static constexpr size_t MIN_CHUNK = 8;
+    static constexpr int CLASSES = 6;  // 8 to 256 bytes
+    static_assert((MIN_CHUNK << (CLASSES - 1)) > MAX_NAME_BYTES, "largest chunk holds any name");
+
+    struct Entry {
+        std::string_view text;  // Views a chunk in the blocks
+        uint32_t uses;
+        uint8_t sizeClass;
+    };
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t used = 0;                             // Bytes taken in the last block
+    std::array<std::vector<char*>, CLASSES> spare;  // Freed chunks by class
+    std::vector<Entry> entries;                  // By id
+    std::vector<uint32_t> freeIds;
+    std::unordered_map<std::string_view, uint32_t> index;
+
+    static int classOf(size_t bytes) {
+        int c = 0;
+        while ((MIN_CHUNK << c) < bytes) ++c;
+        return c;
+    }
+
+    // A chunk of the class, reusing a freed one first. Chunks never straddle
+    // blocks, so views into a block stay valid.
+    char* takeChunk(int sizeClass) {
+        if (!spare[sizeClass].empty()) {
+            char* chunk = spare[sizeClass].back();
+            spare[sizeClass].pop_back();
+            return chunk;
+        }
+        size_t bytes = MIN_CHUNK << sizeClass;
+        if (blocks.empty() || used + bytes > BLOCK_BYTES) {
+            blocks.emplace_back(new char[BLOCK_BYTES]);
+            used = 0;
+        }
+        char* chunk = blocks.back().get() + used;
+        used += bytes;
+        return chunk;
+    }
+};
+
+/*******************************************************************************
+ * GAME POOL
+ ******************************************************************************/
+
+struct GameHandle {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+// One resident game
+struct GameSlot {
+    GameState state;
+    uint32_t rounds;                          // Number rounds played
+    std::array<uint32_t, MAX_PLAYERS> names;  // NamePool ids by seat
+    uint32_t generation;                      // Changes each time the slot is released
+    uint32_t nextFree;                        // Free-list link while released
+};
+
+class GamePool {
+public:
+    static constexpr uint32_t SLOTS_PER_PAGE = 1024;
+
+    // Deals a new game for the given names (2-6 of them).
+    GameHandle create(const RuleTables& tables, const std::vector<std::string>& playerNames) {
+        GameState fresh;
+        fresh.reset(tables, static_cast<int>(playerNames.size()));
+        return restore(fresh, 0, playerNames);
+    }
+
+    // Places a game in progress, e.g. one read back from disk. Callers check
+    // the player count (MIN_PLAYERS to MAX_PLAYERS names).
+    GameHandle restore(const GameState& state, uint32_t rounds, const std::vector<std::string>& playerNames) {
+        assert(playerNames.size() >= MIN_PLAYERS && playerNames.size() <= MAX_PLAYERS);
+        if (freeHead == NO_SLOT) grow();
+        uint32_t index = freeHead;
+        GameSlot& slot = at(index);
+        freeHead = slot.nextFree;
+
+        slot.state = state;
+        slot.rounds = rounds;
+        slot.names.fill(NO_NAME);
+        for (size_t i = 0; i < playerNames.size(); ++i) slot.names[i] = namePool.intern(playerNames[i]);
+        slot.nextFree = NO_SLOT;
+        live[index / 64] |= uint64_t(1) << (index % 64);
+        ++liveCount;
+        return {index, slot.generation};
+    }
+
+    // Ends a game; false if the handle is stale.
+    bool release(GameHandle h) {
+        if (!find(h)) return false;
+        GameSlot& slot = at(h.slot);
+        for (uint32_t id : slot.names) {
+            if (id != NO_NAME) namePool.release(id);
+        }
+        ++slot.generation;
+        slot.nextFree = freeHead;
+        freeHead = h.slot;
+        live[h.slot / 64] &= ~(uint64_t(1) << (h.slot % 64));
+        --liveCount;
+        return true;
+    }
+
+    // The game behind a handle, or null once it has been released
+    GameSlot* find(GameHandle h) {
+        if (h.slot >= capacity() || !(live[h.slot / 64] >> (h.slot % 64) & 1)) return nullptr;
+        GameSlot& slot = at(h.slot);
+        return slot.generation == h.generation ? &slot : nullptr;
+    }
+    const GameSlot* find(GameHandle h) const { return const_cast<GamePool*>(this)->find(h); }
+
+    std::string_view name(const GameSlot& slot, int seat) const { return namePool.name(slot.names[seat]); }
+
+    // Calls fn(handle, slot) for every live game, in slot order.
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (size_t word = 0; word < live.size(); ++word) {
+            for (uint64_t bits = live[word]; bits; bits &= bits - 1) {
+                uint32_t index = static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits));
+                GameSlot& slot = at(index);
+                fn(GameHandle{index, slot.generation}, slot);
+            }
+        }
+    }
+
+    size_t size() const { return liveCount; }
+    uint32_t capacity() const { return static_cast<uint32_t>(pages.size()) * SLOTS_PER_PAGE; }
+    const NamePool& namesInUse() const { return namePool; }
+
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+    static constexpr uint32_t NO_NAME = UINT32_MAX;  // Seat past the last player
+    static_assert(SLOTS_PER_PAGE % 64 == 0, "whole bitmap words per page");
+
+    std::vector<std::unique_ptr<GameSlot[]>> pages;
+    std::vector<uint64_t> live;  // Bit per slot
+    uint32_t freeHead = NO_SLOT;
+    size_t liveCount = 0;
+    NamePool namePool;
+
+    GameSlot& at(uint32_t index) { return pages[index / SLOTS_PER_PAGE][index % SLOTS_PER_PAGE]; }
+
+    // Adds a page and threads its slots onto the free list in order
+    void grow() {
+        uint32_t first = capacity();
+        pages.emplace_back(new GameSlot[SLOTS_PER_PAGE]());
+        live.resize(live.size() + SLOTS_PER_PAGE / 64, 0);
+        GameSlot* page = pages.back().get();
+        for (uint32_t i = 0; i < SLOTS_PER_PAGE; ++i) {
+            page[i].nextFree = i + 1 < SLOTS_PER_PAGE ? first + i + 1 : freeHead;
+        }
+        freeHead = first;
+    }
+};
+
+#endif // SPLIT_UNO_GAME_POOL_H
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * SPLIT UNO - GAME STATE
+ *
+ * Count-based game state for 2-6 players in structure-of-arrays form: each
+ * per-player field is its own contiguous array indexed by seat, so passes
+ * over all players (shedding, streak resets, bonus checks) touch one small
+ * array each. Player names are kept outside the state by the arbiter.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_GAME_STATE_H
+#define SPLIT_UNO_GAME_STATE_H
+
+#include <array>
+#include <cstdint>
+
+#include "rules.h"
+
+constexpr int MIN_PLAYERS = 2;
+constexpr int MAX_PLAYERS = 6;
+constexpr int NO_CARD = -1;    // Bid marker for a blocked player
+constexpr int NO_WINNER = -1;  // Winner marker while the game is running
+
+struct GameState {
+    int numPlayers;
+    std::array<int, MAX_PLAYERS> numberCards;      // Number cards in hand
+    std::array<int, MAX_PLAYERS> actionCards;      // Action cards in hand
+    std::array<int, MAX_PLAYERS> consecutiveWins;  // Current win streak
+    std::array<uint8_t, MAX_PLAYERS> blocked;      // 1 = skips next number round
+    int numberDeckRemaining;                       // Remaining number cards in deck
+    int actionDeckRemaining;                       // Remaining action cards in deck
+    bool gameOver;                                 // Has the game ended?
+    int winner;                                    // Winning seat or NO_WINNER
+
+    // Deals a fresh game. Unused seats stay zeroed so whole-array passes
+    // need no bounds other than numPlayers.
+    void reset(const RuleTables& tables, int players) {
+        numPlayers = players;
+        numberCards.fill(0);
+        actionCards.fill(0);
+        consecutiveWins.fill(0);
+        blocked.fill(0);
+        for (int i = 0; i < numPlayers; ++i) numberCards[i] = tables.initialCards;
+        numberDeckRemaining = tables.numberDeckAfterDeal(players);
+        actionDeckRemaining = tables.initialActionDeck;
+        gameOver = false;
+        winner = NO_WINNER;
+    }
+};
+
+#endif // SPLIT_UNO_GAME_STATE_H
@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * SPLIT UNO - GAME STORE
+ *
+ * Hibernation tier over a GamePool for hosts with many tables that sit idle
+ * between rounds. Games are addressed by the host's own 64-bit id (a table
+ * number, say). Only games used recently are resident: hibernateIdle writes
+ * every game idle for longer than the timeout to its own small file in the
+ * store directory, in the saved-game format, and frees its slot. The next
+ * open() of that id reads it back into a slot, so callers never see the
+ * difference apart from the disk read.
+ *
+ * Memory is bounded by the games resident at once: the index holds resident
+ * games only, hibernated ones are found by file name, and freed slots and
+ * the names only they used are reused by the pool. The file is kept after
+ * waking as a backup and is rewritten at the next hibernation; end()
+ * deletes it.
+ *
+ * Times are whatever monotonic clock the host uses (milliseconds, say); the
+ * store only compares them.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_GAME_STORE_H
+#define SPLIT_UNO_GAME_STORE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "game_pool.h"
+#include "game_state.h"
+#include "rules.h"
+#include "save_game.h"
+
+class GameStore {
+public:
+    // directory must exist; rulesId is rulesFingerprint<Rules>(tables).
+    GameStore(std::string directory, uint32_t rulesId, uint64_t idleTimeout)
+        : directory(std::move(directory)), rulesId(rulesId), idleTimeout(idleTimeout) {}
+
+    // Deals a new game under id; fails if the id is already in use or the
+    // player count is out of range.
+    bool create(uint64_t id, const RuleTables& tables, const std::vector<std::string>& names, uint64_t now,
+                std::string& error) {
+        if (names.size() < MIN_PLAYERS || names.size() > MAX_PLAYERS) {
+            error = "game " + std::to_string(id) + " needs " + std::to_string(MIN_PLAYERS) + "-" +
+                    std::to_string(MAX_PLAYERS) + " players";
+            return false;
+        }
+        if (resident.count(id) || hibernated(id)) {
+            error = "game " + std::to_string(id) + " already exists";
+            return false;
+        }
+        resident.emplace(id, Entry{games.create(tables, names), now});
+        return true;
+    }
+
+    // The game with this id, woken from disk if it was hibernated; null with
+    // error if there is no such game or its file cannot be read. Counts as use.
+    GameSlot* open(uint64_t id, uint64_t now, std::string& error) {
+        auto found = resident.find(id);
+        if (found != resident.end()) {
+            found->second.lastUsed = now;
+            return games.find(found->second.handle);
+        }
+        SavedGame saved;
+        if (!loadGame(path(id), rulesId, saved, error)) {
+            if (!hibernated(id)) error = "no game " + std::to_string(id);
+            return nullptr;
+        }
+        GameHandle handle = games.restore(saved.state, saved.rounds, saved.names);
+        resident.emplace(id, Entry{handle, now});
+        ++wakeCount;
+        return games.find(handle);
+    }
+
+    // Removes a game from memory and disk.
+    bool end(uint64_t id, std::string& error) {
+        auto found = resident.find(id);
+        bool known = found != resident.end() || hibernated(id);
+        if (!known) {
+            error = "no game " + std::to_string(id);
+            return false;
+        }
+        if (found != resident.end()) {
+            games.release(found->second.handle);
+            resident.erase(found);
+        }
+        std::remove(path(id).c_str());
+        return true;
+    }
+
+    // Writes out every game idle since before now - timeout and frees its
+    // slot. A game that cannot be written stays resident; the last error is
+    // reported. Returns the number of games hibernated.
+    size_t hibernateIdle(uint64_t now, std::string& error) {
+        size_t count = 0;
+        for (auto it = resident.begin(); it != resident.end();) {
+            if (now < it->second.lastUsed + idleTimeout) {
+                ++it;
+                continue;
+            }
+            const GameSlot& slot = *games.find(it->second.handle);
+            SavedGame saved{slot.state, slot.rounds, {}};
+            for (int i = 0; i < slot.state.numPlayers; ++i) saved.names.emplace_back(games.name(slot, i));
+            if (!saveGame(path(it->first), saved, rulesId, error)) {
+                ++it;
+                continue;
+            }
+            games.release(it->second.handle);
+            it = resident.erase(it);
+            ++count;
+        }
+        return count;
+    }
+
+    size_t residentGames() const { return resident.size(); }
+    uint64_t wakeUps() const { return wakeCount; }
+    const GamePool& pool() const { return games; }
+    std::string_view name(const GameSlot& slot, int seat) const { return games.name(slot, seat); }
+
+private:
+    struct Entry {
+        GameHandle handle;
+        uint64_t lastUsed;
+    };
+
+    std::string directory;
+    uint32_t rulesId;
+    uint64_t idleTimeout;
+    GamePool games;
+    std::unordered_map<uint64_t, Entry> resident;
+    uint64_t wakeCount = 0;
+
+    std::string path(uint64_t id) const { return directory + "/game-" + std::to_string(id) + ".sav"; }
+
+    bool hibernated(uint64_t id) const {
+        std::FILE* file = std::fopen(path(id).c_str(), "rb");
+        if (file) std::fclose(file);
+        return file != nullptr;
+    }
+};
+
+#endif // SPLIT_UNO_GAME_STORE_H
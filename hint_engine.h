@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * SPLIT UNO - HINT ENGINE
+ *
+ * Runs the advisor on a background thread while the operator is still
+ * typing. When a decision prompt opens, the arbiter posts it with start()
+ * and returns to reading input at once; the worker deepens the search
+ * until the prompt is answered and publishes every finished pass, so a
+ * "hint" typed at the prompt shows the best ranking found so far without
+ * waiting for anything.
+ *
+ * start(), cancel() and current() only take a mutex that the worker holds
+ * for a copy, never during the search, so input is not delayed. The
+ * advisor's memo table is kept between prompts, and consecutive prompts of
+ * one round (same bid odds) reuse each other's work.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_HINT_ENGINE_H
+#define SPLIT_UNO_HINT_ENGINE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "advisor.h"
+#include "game_state.h"
+#include "rules.h"
+
+using BidOdds = std::array<std::array<float, NUM_CARD_VALUES>, 2>;
+
+// What the worker has found for the open prompt
+struct HintStatus {
+    bool open = false;       // A decision prompt is waiting for input
+    bool searching = false;  // Deeper passes are still running
+    Decision decision = Decision::DRAW_COUNTER;
+    int decider = 0;
+    Advice advice;           // count 0 until the first pass; depth 0 = static ranking
+};
+
+template <typename Rules>
+class HintEngine {
+public:
+    explicit HintEngine(const RuleTables& rules, const AdvisorSettings& settings = {})
+        : advisor(rules, settings), worker([this] { loop(); }) {}
+
+    HintEngine(const HintEngine&) = delete;
+    HintEngine& operator=(const HintEngine&) = delete;
+
+    ~HintEngine() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+            stop = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    // Starts searching a prompt, abandoning any earlier one.
+    void start(const GameState& s, Decision d, int decider, int amount, const BidOdds& odds) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = {s, d, decider, amount, odds};
+            pending = true;
+            ++generation;
+            status = HintStatus{};
+            status.open = status.searching = true;
+            status.decision = d;
+            status.decider = decider;
+            stop = true;
+        }
+        wake.notify_one();
+    }
+
+    // Stops the search once the prompt has been answered.
+    void cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = false;
+        ++generation;
+        status = HintStatus{};
+        stop = true;
+    }
+
+    HintStatus current() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return status;
+    }
+
+private:
+    struct Job {
+        GameState state;
+        Decision decision;
+        int decider;
+        int amount;
+        BidOdds odds;
+    };
+
+    Advisor<Rules> advisor;  // Used by the worker thread only
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<bool> stop{false};
+
+    // Guarded by mutex
+    Job job{};
+    bool pending = false;
+    bool quit = false;
+    uint64_t generation = 0;
+    HintStatus status;
+
+    std::thread worker;  // Declared last: starts once everything above exists
+
+    void loop() {
+        while (true) {
+            Job next;
+            uint64_t mine;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return pending || quit; });
+                if (quit) return;
+                next = job;
+                pending = false;
+                mine = generation;
+                stop = false;
+            }
+            for (int seat = 0; seat < 2; ++seat) advisor.setBidOdds(seat, next.odds[seat]);
+            advisor.ponder(next.state, next.decision, next.decider, next.amount, stop, [&](const Advice& a) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (generation == mine) status.advice = a;
+            });
+            std::lock_guard<std::mutex> lock(mutex);
+            if (generation == mine) status.searching = false;
+        }
+    }
+};
+
+#endif // SPLIT_UNO_HINT_ENGINE_H
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * SPLIT UNO - STATE HISTORY
+ *
+ * Undo/redo for the arbiter. Every menu step that changes the game appends
+ * an immutable, packed copy of the state (about 40 bytes) to a flat list
+ * and moves a cursor; undo and redo only move the cursor back and forth
+ * and unpack one version, so each step costs constant time and memory no
+ * matter how long the game runs. A new step after an undo drops the
+ * versions that could have been redone.
+ *
+ * The bids a step fed to the bid model are kept with it in one flat list,
+ * so undo and redo can take them out of the model and put them back.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_HISTORY_H
+#define SPLIT_UNO_HISTORY_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "bid_model.h"
+#include "game_state.h"
+
+// GameState narrowed to the ranges the arbiter allows, plus the round count
+struct StateVersion {
+    uint32_t rounds;
+    int16_t numberDeck;
+    int16_t actionDeck;
+    std::array<int16_t, MAX_PLAYERS> numberCards;
+    std::array<int16_t, MAX_PLAYERS> actionCards;
+    std::array<uint8_t, MAX_PLAYERS> streak;
+    std::array<uint8_t, MAX_PLAYERS> blocked;
+    uint8_t numPlayers;
+    uint8_t gameOver;
+    int8_t winner;
+
+    static StateVersion pack(const GameState& s, uint32_t rounds) {
+        StateVersion v{};
+        v.rounds = rounds;
+        v.numberDeck = static_cast<int16_t>(s.numberDeckRemaining);
+        v.actionDeck = static_cast<int16_t>(s.actionDeckRemaining);
+        for (int i = 0; i < MAX_PLAYERS; ++i) {
+            v.numberCards[i] = static_cast<int16_t>(s.numberCards[i]);
+            v.actionCards[i] = static_cast<int16_t>(s.actionCards[i]);
+            v.streak[i] = static_cast<uint8_t>(s.consecutiveWins[i]);
+            v.blocked[i] = s.blocked[i];
+        }
+        v.numPlayers = static_cast<uint8_t>(s.numPlayers);
+        v.gameOver = s.gameOver;
+        v.winner = static_cast<int8_t>(s.winner);
+        return v;
+    }
+
+    void unpack(GameState& s) const {
+        s.numPlayers = numPlayers;
+        s.numberDeckRemaining = numberDeck;
+        s.actionDeckRemaining = actionDeck;
+        for (int i = 0; i < MAX_PLAYERS; ++i) {
+            s.numberCards[i] = numberCards[i];
+            s.actionCards[i] = actionCards[i];
+            s.consecutiveWins[i] = streak[i];
+            s.blocked[i] = blocked[i];
+        }
+        s.gameOver = gameOver != 0;
+        s.winner = winner;
+    }
+
+    bool operator==(const StateVersion& o) const {
+        return rounds == o.rounds && numberDeck == o.numberDeck && actionDeck == o.actionDeck &&
+               numberCards == o.numberCards && actionCards == o.actionCards && streak == o.streak &&
+               blocked == o.blocked && numPlayers == o.numPlayers && gameOver == o.gameOver &&
+               winner == o.winner;
+    }
+};
+
+class StateHistory {
+public:
+    // Starts a new history whose only version is the given state.
+    void reset(const GameState& s, uint32_t rounds) {
+        versions.clear();
+        versions.push_back(StateVersion::pack(s, rounds));
+        bidsEnd.assign(1, 0);
+        bids.clear();
+        cursor = 0;
+    }
+
+    // Records the state after a step, with the bids the step recorded;
+    // unchanged states are not recorded.
+    void commit(const GameState& s, uint32_t rounds, const std::vector<BidModel::BidChange>& stepBids = {}) {
+        StateVersion v = StateVersion::pack(s, rounds);
+        if (!versions.empty() && versions[cursor] == v) return;
+        versions.resize(cursor + 1);
+        versions.push_back(v);
+        bidsEnd.resize(cursor + 1);
+        bids.resize(bidsEnd[cursor]);
+        bids.insert(bids.end(), stepBids.begin(), stepBids.end());
+        bidsEnd.push_back(static_cast<uint32_t>(bids.size()));
+        cursor = versions.size() - 1;
+    }
+
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor + 1 < versions.size(); }
+
+    // Steps back one version, taking its bids out of model; returns false
+    // at the start of the game.
+    bool undo(GameState& s, uint32_t& rounds, BidModel& model) {
+        if (!canUndo()) return false;
+        model.revert(bids.data() + bidsEnd[cursor - 1], bids.data() + bidsEnd[cursor]);
+        restore(--cursor, s, rounds);
+        return true;
+    }
+
+    // Steps forward again after an undo, putting the bids back.
+    bool redo(GameState& s, uint32_t& rounds, BidModel& model) {
+        if (!canRedo()) return false;
+        restore(++cursor, s, rounds);
+        model.replay(bids.data() + bidsEnd[cursor - 1], bids.data() + bidsEnd[cursor]);
+        return true;
+    }
+
+private:
+    std::vector<StateVersion> versions;
+    std::vector<BidModel::BidChange> bids;  // Bids of every step, in step order
+    std::vector<uint32_t> bidsEnd;          // Per version: end of its step's bids
+    size_t cursor = 0;
+
+    void restore(size_t at, GameState& s, uint32_t& rounds) const {
+        versions[at].unpack(s);
+        rounds = versions[at].rounds;
+    }
+};
+
+#endif // SPLIT_UNO_HISTORY_H
@@ -0,0 +1,389 @@
+/*******************************************************************************
+ * SPLIT UNO - LOCKSTEP SIMULATION
+ *
+ * Plays many 2-player games side by side, one number round per step for
+ * all of them. The state of a batch is stored across games (one vector per
+ * field: hands, action cards, streaks, decks, round count), so each field
+ * of 4 or 8 games is one SIMD register and a round is resolved for all of
+ * them with the same straight-line vector code: bids, 0/7 effects, shedding and
+ * drawing, streak bonuses, the win check and challenges. Finished games are
+ * masked out and their lane is refilled with the next game, so the lanes
+ * stay busy while games of different lengths end.
+ *
+ * The games are those of LockstepBot, a simple policy that never plays
+ * action cards: bids come from a per-seat table (uniform by default),
+ * the streak bonus and challenges follow a fixed answer per seat. Bids are
+ * drawn from a counter-based hash of the game seed, so the kernel and the
+ * bot playing through RuleEngine produce the same games, result for
+ * result; --bench-lockstep checks this.
+ *
+ * The kernel is written with GCC/Clang vector types and compiled twice:
+ * for AVX2 when the CPU has it, and for the baseline instruction set.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_LOCKSTEP_H
+#define SPLIT_UNO_LOCKSTEP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "bots.h"
+#include "engine.h"
+#include "game_state.h"
+#include "rules.h"
+#include "simulate.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SPLIT_UNO_LOCKSTEP_AVX2 1
+#endif
+
+struct LockstepPolicy {
+    static constexpr uint32_t ONE = 1u << 16;  // Probability 1 in bidCdf
+
+    // P(bid <= c) * ONE for c = 0..8, per seat
+    std::array<std::array<uint32_t, NUM_CARD_VALUES - 1>, MAX_PLAYERS> bidCdf;
+    std::array<int, MAX_PLAYERS> bonusChoice;    // BONUS_CHOICE answer: 1 = draw action cards, 2 = opponents draw
+    std::array<int, MAX_PLAYERS> challengeCard;  // Challenge with +2/+4 when holding an action card; 0 = never
+
+    // Uniform bids, opponents draw on a streak, always challenge with +4
+    static LockstepPolicy uniform() {
+        LockstepPolicy p{};
+        std::array<float, NUM_CARD_VALUES> flat;
+        flat.fill(1.0f);
+        for (int seat = 0; seat < MAX_PLAYERS; ++seat) p.setBidOdds(seat, flat);
+        p.bonusChoice.fill(2);
+        p.challengeCard.fill(4);
+        return p;
+    }
+
+    // Bid weights for a seat; need not be normalised.
+    void setBidOdds(int seat, const std::array<float, NUM_CARD_VALUES>& odds) {
+        double total = 0.0;
+        for (float w : odds) total += w > 0.0f ? w : 0.0f;
+        double cumulative = 0.0;
+        for (int c = 0; c < NUM_CARD_VALUES - 1; ++c) {
+            cumulative += total > 0.0 ? (odds[c] > 0.0f ? odds[c] : 0.0f) / total : 1.0 / NUM_CARD_VALUES;
+            double scaled = cumulative * ONE + 0.5;
+            bidCdf[seat][c] = scaled >= ONE ? ONE : static_cast<uint32_t>(scaled);
+        }
+    }
+};
+
+// Per-game hash key from a 64-bit game seed
+inline uint32_t lockstepKey(uint64_t seed) { return static_cast<uint32_t>(seed ^ (seed >> 32)); }
+
+// Counter-based random number: the same (key, counter) always gives the same value
+inline uint32_t lockstepRandom(uint32_t key, uint32_t counter) {
+    uint32_t x = key + counter * 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+inline int lockstepBid(const std::array<uint32_t, NUM_CARD_VALUES - 1>& cdf, uint32_t random) {
+    uint32_t u = random >> 16;
+    int bid = 0;
+    for (uint32_t threshold : cdf) bid += u >= threshold;
+    return bid;
+}
+
+/*******************************************************************************
+ * LOCKSTEP BOT
+ *
+ * The policy as an engine controller, for any number of players. Bid k of
+ * a game (counting all seats) uses counter k.
+ ******************************************************************************/
+
+class LockstepBot : public SilentController {
+public:
+    explicit LockstepBot(uint64_t seed, const LockstepPolicy& policy = LockstepPolicy::uniform())
+        : key(lockstepKey(seed)), rules(policy) {}
+
+    int bid(const GameState&, int player) { return lockstepBid(rules.bidCdf[player], lockstepRandom(key, counter++)); }
+    int target(const GameState& s, int player, Prompt) { return leadingOpponent(s, player); }
+    bool answer(const GameState&, int, Prompt) { return true; }
+    int choice(const GameState&, int player, Prompt prompt) {
+        if (prompt == Prompt::BONUS_CHOICE) return rules.bonusChoice[player];
+        return prompt == Prompt::COLOR_CHOICE ? 0 : 2;
+    }
+    int drawCounter(const GameState&, int, int) { return 0; }
+    int challenger(const GameState& s, int winnerIdx) {
+        int best = NO_CHALLENGE;
+        for (int i = 0; i < s.numPlayers; ++i) {
+            if (i == winnerIdx || !rules.challengeCard[i] || s.actionCards[i] == 0) continue;
+            if (best == NO_CHALLENGE || s.actionCards[i] > s.actionCards[best]) best = i;
+        }
+        return best;
+    }
+    int challengeCard(const GameState&, int challengerIdx, int) { return rules.challengeCard[challengerIdx]; }
+    ActionType action(const GameState&, int, uint16_t) { return ActionType::UNKNOWN; }
+
+private:
+    uint32_t key;
+    uint32_t counter = 0;
+    LockstepPolicy rules;
+};
+
+/*******************************************************************************
+ * KERNEL
+ ******************************************************************************/
+
+namespace lockstep_detail {
+
+// Lane vectors of N 32-bit games; N matches the register width of the
+// target (4 for SSE2, 8 for AVX2) so that no operation is split up or
+// scalarised by the compiler.
+template <int N>
+struct LaneTypes {
+    typedef int32_t Int __attribute__((vector_size(4 * N)));
+    typedef uint32_t Uint __attribute__((vector_size(4 * N)));
+};
+
+// Vectors are only passed by reference: by value, the generic and AVX2
+// builds would disagree on the calling convention (and GCC warns).
+#define SPLIT_UNO_LANES inline __attribute__((always_inline))
+
+// a = min(a, b) in every lane; comparisons give -1/0 masks, which stay in
+// vector registers where a lane-wise ?: would not on every target
+template <typename V>
+SPLIT_UNO_LANES void minLanes(V& a, const V& b) {
+    a = b ^ ((a ^ b) & (a < b));
+}
+
+// Draws up to amount from deck in every lane; decks never go negative, so
+// this matches RuleEngine's draw clamping
+template <typename V>
+SPLIT_UNO_LANES void drawLanes(V& deck, const V& amount, V& hand) {
+    V taken = amount;
+    minLanes(taken, deck);
+    deck -= taken;
+    hand += taken;
+}
+
+// lockstepRandom's finaliser
+template <typename V>
+SPLIT_UNO_LANES void hashLanes(V& x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+}
+
+// Rules and policy flattened for the kernel
+struct KernelTables {
+    int initialCards, initialNumberDeck, initialActionDeck, threshold;
+    int winnerShed, loserDraw, tieShed, tieDraw, tieStreakKeep, bonusActionDraw, bonusOpponentDraw;
+    std::array<int32_t, NUM_CARD_VALUES> effect;  // steal | penaltyNumber << 8 | penaltyAction << 16
+    std::array<int, NUM_CARD_VALUES> specialCards;  // Cards with a non-zero effect
+    int numSpecial;
+    std::array<std::array<int32_t, NUM_CARD_VALUES - 1>, 2> bidCdf;
+    std::array<int, 2> bonusChoice, challengeCard;
+};
+
+inline KernelTables flatten(const RuleTables& t, const LockstepPolicy& p) {
+    KernelTables k{t.initialCards, t.numberDeckAfterDeal(2), t.initialActionDeck, t.consecutiveWinsThreshold,
+                   t.winnerShed, t.loserDraw, t.tieShed, t.tieDraw, t.tieStreakKeep, t.bonusActionDraw,
+                   t.bonusOpponentDraw, {}, {}, 0, {}, {}, {}};
+    for (int c = 0; c < NUM_CARD_VALUES; ++c) {
+        k.effect[c] = t.bidSteal[c] | t.bidPenaltyNumber[c] << 8 | t.bidPenaltyAction[c] << 16;
+        if (k.effect[c]) k.specialCards[k.numSpecial++] = c;
+    }
+    for (int seat = 0; seat < 2; ++seat) {
+        for (int c = 0; c < NUM_CARD_VALUES - 1; ++c) k.bidCdf[seat][c] = static_cast<int32_t>(p.bidCdf[seat][c]);
+        k.bonusChoice[seat] = p.bonusChoice[seat];
+        k.challengeCard[seat] = p.challengeCard[seat];
+    }
+    return k;
+}
+
+// One game per lane; "over" is a lane mask
+template <int N>
+struct Lanes {
+    typedef typename LaneTypes<N>::Int Int;
+    typedef typename LaneTypes<N>::Uint Uint;
+    Int cards[2], actions[2], streak[2];
+    Int numberDeck, actionDeck, rounds, over, winner;
+    Uint key;
+};
+
+// One number round in every lane, in the order of RuleEngine::handleNumberRound.
+// The short per-seat loops are unrolled so bids and masks stay in registers.
+template <int N, bool CHALLENGES>
+SPLIT_UNO_LANES void playRound(Lanes<N>& g, const KernelTables& k) {
+    typedef typename Lanes<N>::Int Int;
+    typedef typename Lanes<N>::Uint Uint;
+    const Uint counter = reinterpret_cast<const Uint&>(g.rounds) * 2u;
+    Int bid[2];
+    Int effect[2];
+#pragma GCC unroll 2
+    for (int seat = 0; seat < 2; ++seat) {
+        Uint x = g.key + (counter + static_cast<uint32_t>(seat)) * 0x9E3779B9u;
+        hashLanes(x);
+        x >>= 16;
+        const Int& u = reinterpret_cast<const Int&>(x);
+        bid[seat] = Int{};
+#pragma GCC unroll 9
+        for (int c = 0; c < NUM_CARD_VALUES - 1; ++c) bid[seat] -= u >= k.bidCdf[seat][c];
+        effect[seat] = Int{};
+        for (int i = 0; i < k.numSpecial; ++i) {
+            int c = k.specialCards[i];
+            effect[seat] += (bid[seat] == c) & k.effect[c];
+        }
+    }
+
+    // Card 0 and card 7 effects, seat 0 first
+#pragma GCC unroll 2
+    for (int i = 0; i < 2; ++i) {
+        int other = 1 - i;
+        Int stolen = effect[i] & 0xFF;
+        minLanes(stolen, g.cards[other]);
+        g.cards[i] += stolen;
+        g.cards[other] -= stolen;
+        drawLanes(g.numberDeck, Int((effect[i] >> 8) & 0xFF), g.cards[other]);
+        drawLanes(g.actionDeck, Int(effect[i] >> 16), g.actions[other]);
+    }
+
+    // Winner sheds and loser draws, or both shed and draw on a tie
+    const Int tie = bid[0] == bid[1];
+    const Int won[2] = {bid[0] > bid[1], bid[1] > bid[0]};
+#pragma GCC unroll 2
+    for (int i = 0; i < 2; ++i) {
+        Int left = g.cards[i] - ((tie & k.tieShed) | (won[i] & k.winnerShed));
+        g.cards[i] = left & (left > 0);
+        g.streak[i] = (tie & (g.streak[i] * k.tieStreakKeep)) | (won[i] & (g.streak[i] + 1));
+    }
+#pragma GCC unroll 2
+    for (int i = 0; i < 2; ++i) {
+        drawLanes(g.numberDeck, Int((tie & k.tieDraw) | (won[1 - i] & k.loserDraw)), g.cards[i]);
+    }
+
+    // Streak bonus
+    const Int earned[2] = {g.streak[0] >= k.threshold, g.streak[1] >= k.threshold};
+#pragma GCC unroll 2
+    for (int p = 0; p < 2; ++p) {
+        if (k.bonusChoice[p] == 1) {
+            drawLanes(g.actionDeck, Int(earned[p] & k.bonusActionDraw), g.actions[p]);
+        } else {
+            drawLanes(g.numberDeck, Int(earned[p] & k.bonusOpponentDraw), g.cards[1 - p]);
+        }
+        g.streak[p] &= ~earned[p];
+    }
+
+    // Win check, with the opponent's challenge
+#pragma GCC unroll 2
+    for (int i = 0; i < 2; ++i) {
+        int opp = 1 - i;
+        Int empty = (g.cards[i] == 0) & ~g.over;
+        Int challenged = Int{};
+        if constexpr (CHALLENGES) {
+            if (k.challengeCard[opp]) challenged = empty & (g.actions[opp] > 0);
+        }
+        Int ends = empty & ~challenged;
+        g.winner = (ends & i) | (~ends & g.winner);
+        g.over |= ends;
+        drawLanes(g.numberDeck, Int(challenged & k.challengeCard[opp]), g.cards[i]);
+        g.actions[opp] += challenged;  // Masks are -1: the challenger spends one action card
+    }
+    g.rounds += 1;
+}
+
+// Plays games [0, count) from their seeds through GROUPS groups of N lanes.
+// A round is one long dependency chain (hash, bid, effects, deck draws), so
+// independent groups are interleaved to keep the vector units busy.
+template <int N, int GROUPS, bool CHALLENGES>
+SPLIT_UNO_LANES void runLanes(const KernelTables& k, const uint64_t* seeds, size_t count, GameResult* out) {
+    typedef typename Lanes<N>::Int Int;
+    Lanes<N> groups[GROUPS] = {};
+    std::array<int64_t, N * GROUPS> game;
+    size_t next = 0;
+    int live = 0;
+
+    auto load = [&](Lanes<N>& g, int slot, int l) {
+        if (next == count) {
+            game[slot] = -1;
+            g.over[l] = -1;
+            return;
+        }
+        game[slot] = static_cast<int64_t>(next);
+        g.key[l] = lockstepKey(seeds[next++]);
+        g.cards[0][l] = g.cards[1][l] = k.initialCards;
+        g.actions[0][l] = g.actions[1][l] = 0;
+        g.streak[0][l] = g.streak[1][l] = 0;
+        g.numberDeck[l] = k.initialNumberDeck;
+        g.actionDeck[l] = k.initialActionDeck;
+        g.rounds[l] = 0;
+        g.over[l] = 0;
+        g.winner[l] = NO_WINNER;
+        ++live;
+    };
+    for (int j = 0; j < GROUPS; ++j) {
+        for (int l = 0; l < N; ++l) load(groups[j], j * N + l, l);
+    }
+
+    while (live > 0) {
+        for (Lanes<N>& g : groups) playRound<N, CHALLENGES>(g, k);
+        for (int j = 0; j < GROUPS; ++j) {
+            Lanes<N>& g = groups[j];
+            Int done = g.over | (g.rounds >= static_cast<int32_t>(MAX_SIMULATED_ROUNDS));
+            int any = 0;
+            for (int l = 0; l < N; ++l) any |= done[l];
+            if (!any) continue;
+            for (int l = 0; l < N; ++l) {
+                int slot = j * N + l;
+                if (game[slot] < 0 || !done[l]) continue;
+                out[game[slot]] = {g.over[l] ? g.winner[l] : NO_WINNER, static_cast<uint32_t>(g.rounds[l])};
+                --live;
+                load(g, slot, l);
+            }
+        }
+    }
+}
+
+template <bool CHALLENGES>
+inline void runGeneric(const KernelTables& k, const uint64_t* seeds, size_t count, GameResult* out) {
+    runLanes<4, 4, CHALLENGES>(k, seeds, count, out);
+}
+
+#ifdef SPLIT_UNO_LOCKSTEP_AVX2
+template <bool CHALLENGES>
+__attribute__((target("avx2"))) inline void runAvx2(const KernelTables& k, const uint64_t* seeds, size_t count,
+                                                     GameResult* out) {
+    runLanes<8, 4, CHALLENGES>(k, seeds, count, out);
+}
+
+inline bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+#undef SPLIT_UNO_LANES
+
+}  // namespace lockstep_detail
+
+enum class LockstepKernel : uint8_t { AUTO, GENERIC, AVX2 };
+
+// Plays one 2-player LockstepBot game per seed and writes out[i] for
+// seeds[i]; the results equal those of playGameWith<Rules>(LockstepBot).
+template <typename Rules>
+void playLockstepGames(const RuleTables& tables, const LockstepPolicy& policy, const uint64_t* seeds, size_t count,
+                       GameResult* out, LockstepKernel kernel = LockstepKernel::AUTO) {
+    using namespace lockstep_detail;
+    const KernelTables k = flatten(tables, policy);
+#ifdef SPLIT_UNO_LOCKSTEP_AVX2
+    if (kernel != LockstepKernel::GENERIC && cpuHasAvx2()) {
+        runAvx2<Rules::CHALLENGES_ENABLED>(k, seeds, count, out);
+        return;
+    }
+#else
+    (void)kernel;
+#endif
+    runGeneric<Rules::CHALLENGES_ENABLED>(k, seeds, count, out);
+}
+
+#endif // SPLIT_UNO_LOCKSTEP_H
@@ -0,0 +1,512 @@
+/*******************************************************************************
+ * SPLIT UNO - MODEL CHECKER
+ *
+ * Bounded exhaustive exploration of the rule engine. Starting from small
+ * deals (a few cards each, tiny decks, every split of starting action
+ * cards), it follows every step a game can take - any seat holding an
+ * action card plays any playable type, or a number round is played - and
+ * inside each step every answer to every prompt the handler asks: all
+ * bids, targets, yes/no answers, menu choices, counters and challenges.
+ *
+ * Each step is checked against invariants that hold under every rule
+ * variant and house-rule set:
+ *   - no count is negative, decks never grow past their starting size,
+ *     unused seats stay empty and blocks are 0/1
+ *   - no card is created: hands plus deck never increase, for number and
+ *     for action cards
+ *   - gameOver is set exactly when a winner is
+ *   - after a number round no block is left and every streak is below the
+ *     bonus threshold
+ *   - REVERSE exchanges the two hands, then the player sheds one action card
+ *
+ * Exploration is breadth first, one level per step. Workers expand chunks
+ * of the current level and drop states already seen through a sharded
+ * concurrent hash set, so each distinct state is expanded once.
+ *
+ * Bids are enumerated up to equivalence: a number round only depends on
+ * the effects of each seat's card (steal, penalty) and on which seats
+ * played the highest one, so one bid vector per such pattern is played.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_MODEL_CHECK_H
+#define SPLIT_UNO_MODEL_CHECK_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "action_table.h"
+#include "bots.h"
+#include "engine.h"
+#include "game_state.h"
+#include "rule_events.h"
+#include "rules.h"
+
+struct ModelCheckSettings {
+    int numPlayers = MIN_PLAYERS;
+    int cards = 3;            // Number cards dealt to each seat
+    int maxActionCards = 1;   // Starting action cards: every split of 0..max per seat
+    int numberDeck = 4;
+    int actionDeck = 2;
+    int maxDepth = 0;         // Steps from the deal; 0 = until no new state appears
+    unsigned threads = 0;     // 0 = one per core
+    size_t maxViolations = 10;  // Examples kept for the report
+};
+
+struct ModelViolation {
+    GameState before;
+    std::string step;       // "P1 plays REVERSE" or "number round"
+    std::string decisions;  // Answers given inside the step
+    std::string message;
+};
+
+struct ModelCheckResult {
+    uint64_t states = 0;       // Distinct states reached, deals included
+    uint64_t transitions = 0;  // Handler runs (step x decision sequence)
+    int depth = 0;             // Deepest level with new states
+    bool complete = false;     // Every reachable state was expanded
+    uint64_t violationCount = 0;
+    std::vector<ModelViolation> violations;
+};
+
+namespace model_check_detail {
+
+// Compact, padding-free copy of a state for the visited set
+struct StateKey {
+    std::array<uint8_t, 32> bytes;
+    bool operator==(const StateKey& o) const { return bytes == o.bytes; }
+};
+
+struct StateKeyHash {
+    size_t operator()(const StateKey& k) const {
+        uint64_t h = 0;
+        for (int w = 0; w < 4; ++w) {
+            uint64_t word;
+            std::memcpy(&word, k.bytes.data() + 8 * w, sizeof word);
+            h = splitMix64(h ^ word);
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+inline StateKey keyOf(const GameState& s) {
+    StateKey k{};
+    k.bytes[0] = static_cast<uint8_t>(s.numPlayers);
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        k.bytes[1 + i] = static_cast<uint8_t>(s.numberCards[i]);
+        k.bytes[7 + i] = static_cast<uint8_t>(s.actionCards[i]);
+        k.bytes[13 + i] = static_cast<uint8_t>(s.consecutiveWins[i]);
+        k.bytes[19 + i] = s.blocked[i];
+    }
+    k.bytes[25] = static_cast<uint8_t>(s.numberDeckRemaining);
+    k.bytes[26] = static_cast<uint8_t>(s.actionDeckRemaining);
+    k.bytes[27] = s.gameOver;
+    k.bytes[28] = static_cast<uint8_t>(s.winner + 1);
+    return k;
+}
+
+// Sharded set; each shard has its own lock, so threads rarely wait.
+class VisitedSet {
+public:
+    // True if k was not in the set before.
+    bool insert(const StateKey& k) {
+        size_t h = StateKeyHash{}(k);
+        Shard& shard = shards[h >> 58];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.keys.insert(k).second;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<StateKey, StateKeyHash> keys;
+    };
+    std::array<Shard, 64> shards;
+};
+
+using BidVector = std::array<int8_t, MAX_PLAYERS>;
+
+// One bid vector of each length per pattern of card effects and top seats
+inline std::vector<std::vector<BidVector>> representativeBids(const RuleTables& tables, int numPlayers) {
+    std::array<int, NUM_CARD_VALUES> effect;
+    for (int c = 0; c < NUM_CARD_VALUES; ++c) {
+        effect[c] = c;
+        for (int d = 0; d < c; ++d) {
+            if (tables.bidSteal[d] == tables.bidSteal[c] && tables.bidPenaltyNumber[d] == tables.bidPenaltyNumber[c] &&
+                tables.bidPenaltyAction[d] == tables.bidPenaltyAction[c]) {
+                effect[c] = effect[d];
+                break;
+            }
+        }
+    }
+    std::vector<std::vector<BidVector>> lists(numPlayers + 1);
+    for (int k = 1; k <= numPlayers; ++k) {
+        std::unordered_set<uint64_t> seen;
+        BidVector bids{};
+        while (true) {
+            int top = 0;
+            for (int j = 0; j < k; ++j) top = std::max<int>(top, bids[j]);
+            uint64_t pattern = 0;
+            for (int j = 0; j < k; ++j) pattern = pattern * 32 + static_cast<uint64_t>(effect[bids[j]] * 2 + (bids[j] == top));
+            if (seen.insert(pattern).second) lists[k].push_back(bids);
+            int j = 0;
+            while (j < k && ++bids[j] == NUM_CARD_VALUES) bids[j++] = 0;
+            if (j == k) break;
+        }
+    }
+    return lists;
+}
+
+// Replays one decision sequence per run and enumerates all of them in
+// odometer order: after a run, advance() moves to the next sequence.
+class ExploringController : public SilentController {
+public:
+    static constexpr int MAX_DECISIONS = 32;  // A 6-player number round needs about 20
+
+    // bidLists[k]: the bid vectors to try when k seats bid
+    explicit ExploringController(const std::vector<std::vector<BidVector>>& lists) : bidLists(lists) {}
+
+    // Starts the first sequence of a new step.
+    void reset() {
+        known = 0;
+        overflow = false;
+        restart();
+    }
+
+    // Starts another run of the current sequence.
+    void restart() {
+        depth = 0;
+        logged = 0;
+        bids = nullptr;
+    }
+
+    bool advance() {
+        for (int i = known - 1; i >= 0; --i) {
+            if (pick[i] + 1 < arity[i]) {
+                ++pick[i];
+                known = i + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The answers of the last run, for reports
+    std::string describe() const {
+        std::string out;
+        for (int i = 0; i < logged; ++i) {
+            if (i) out += ", ";
+            out += std::string(what[i]) + " " + std::to_string(value[i]);
+        }
+        return out.empty() ? "none" : out;
+    }
+
+    bool overflowed() const { return overflow; }
+
+    // The first bid of a round picks a whole bid vector
+    int bid(const GameState& s, int) {
+        if (!bids) {
+            int bidders = 0;
+            for (int i = 0; i < s.numPlayers; ++i) bidders += !s.blocked[i];
+            const std::vector<BidVector>& list = bidLists[bidders];
+            bids = &list[take(static_cast<int>(list.size()))];
+            nextBid = 0;
+        }
+        return log("bid", (*bids)[nextBid++]);
+    }
+
+    int target(const GameState& s, int player, Prompt) {
+        int p = take(s.numPlayers - 1);
+        return log("target", p + (p >= player));
+    }
+
+    bool answer(const GameState& s, int player, Prompt prompt) {
+        bool mayCounter = prompt != Prompt::BLOCK_COUNTER || s.actionCards[player] > 0;
+        return log("answer", take(mayCounter ? 2 : 1)) != 0;
+    }
+
+    int choice(const GameState&, int, Prompt prompt) {
+        if (prompt == Prompt::COLOR_CHOICE) return log("color", take(4));
+        return log("choice", take(2) + 1);
+    }
+
+    int drawCounter(const GameState& s, int targetIdx, int) {
+        return log("counter", 2 * take(s.actionCards[targetIdx] > 0 ? 3 : 1));
+    }
+
+    int challenger(const GameState& s, int winnerIdx) {
+        std::array<int, MAX_PLAYERS + 1> seats;
+        int count = 0;
+        seats[count++] = NO_CHALLENGE;
+        for (int i = 0; i < s.numPlayers; ++i) {
+            if (i != winnerIdx && s.actionCards[i] > 0) seats[count++] = i;
+        }
+        return log("challenger", seats[take(count)]);
+    }
+
+    int challengeCard(const GameState&, int, int) { return log("challenge", 2 + 2 * take(2)); }
+
+private:
+    static constexpr int MAX_LOG = 64;
+
+    const std::vector<std::vector<BidVector>>& bidLists;
+    const BidVector* bids = nullptr;
+    int nextBid = 0;
+
+    std::array<uint8_t, MAX_DECISIONS> pick{};
+    std::array<uint8_t, MAX_DECISIONS> arity{};
+    int known = 0;  // Leading decisions fixed by the current sequence
+    int depth = 0;  // Decisions taken in this run
+    bool overflow = false;
+
+    std::array<const char*, MAX_LOG> what{};
+    std::array<int, MAX_LOG> value{};
+    int logged = 0;
+
+    // Index of the option to take at the next decision
+    int take(int options) {
+        if (depth == MAX_DECISIONS) {
+            overflow = true;
+            return 0;
+        }
+        if (depth >= known) {
+            pick[depth] = 0;
+            arity[depth] = static_cast<uint8_t>(options);
+            ++known;
+        }
+        return pick[depth++];
+    }
+
+    int log(const char* label, int answer) {
+        if (logged < MAX_LOG) {
+            what[logged] = label;
+            value[logged++] = answer;
+        }
+        return answer;
+    }
+};
+
+// Checks REVERSE against the state it started from.
+struct SwapCheck {
+    const GameState* before = nullptr;
+    std::string error;
+
+    void on(const HandsSwapped& e, const GameState& after) {
+        const GameState& b = *before;
+        bool numbers = after.numberCards[e.player] == b.numberCards[e.target] &&
+                       after.numberCards[e.target] == b.numberCards[e.player];
+        bool actions = after.actionCards[e.player] == std::max(0, b.actionCards[e.target] - 1) &&
+                       after.actionCards[e.target] == b.actionCards[e.player];
+        if (!numbers || !actions) error = "REVERSE did not exchange the two hands";
+    }
+};
+
+inline std::string describeState(const GameState& s) {
+    std::ostringstream out;
+    for (int i = 0; i < s.numPlayers; ++i) {
+        out << "P" << i + 1 << " " << s.numberCards[i] << "/" << s.actionCards[i];
+        if (s.consecutiveWins[i]) out << " streak " << s.consecutiveWins[i];
+        if (s.blocked[i]) out << " blocked";
+        out << ", ";
+    }
+    out << "decks " << s.numberDeckRemaining << "/" << s.actionDeckRemaining;
+    if (s.gameOver) out << ", won by P" << s.winner + 1;
+    return out.str();
+}
+
+// Empty if the step from before to after keeps every invariant.
+inline std::string checkStep(const GameState& before, const GameState& after, bool numberRound,
+                             const RuleTables& tables) {
+    int numberTotal[2] = {before.numberDeckRemaining, after.numberDeckRemaining};
+    int actionTotal[2] = {before.actionDeckRemaining, after.actionDeckRemaining};
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        const bool used = i < after.numPlayers;
+        if (after.numberCards[i] < 0 || after.actionCards[i] < 0 || after.consecutiveWins[i] < 0) {
+            return "negative card count or streak";
+        }
+        if (!used && (after.numberCards[i] || after.actionCards[i] || after.consecutiveWins[i] || after.blocked[i])) {
+            return "unused seat was changed";
+        }
+        if (after.blocked[i] > 1) return "block flag is not 0/1";
+        if (numberRound && after.blocked[i]) return "block outlived the number round";
+        if (numberRound && after.consecutiveWins[i] >= tables.consecutiveWinsThreshold) {
+            return "streak reached the bonus threshold without a bonus";
+        }
+        numberTotal[0] += before.numberCards[i];
+        numberTotal[1] += after.numberCards[i];
+        actionTotal[0] += before.actionCards[i];
+        actionTotal[1] += after.actionCards[i];
+    }
+    if (after.numberDeckRemaining < 0 || after.actionDeckRemaining < 0) return "negative deck";
+    if (after.numberDeckRemaining > before.numberDeckRemaining || after.actionDeckRemaining > before.actionDeckRemaining) {
+        return "deck grew";
+    }
+    if (numberTotal[1] > numberTotal[0]) return "number cards were created";
+    if (actionTotal[1] > actionTotal[0]) return "action cards were created";
+    bool validWinner = after.winner >= 0 && after.winner < after.numPlayers;
+    if (after.gameOver != validWinner || (!after.gameOver && after.winner != NO_WINNER)) {
+        return "gameOver and winner disagree";
+    }
+    return {};
+}
+
+}  // namespace model_check_detail
+
+template <typename Rules>
+ModelCheckResult runModelCheck(const RuleTables& base, const ModelCheckSettings& settings) {
+    using namespace model_check_detail;
+    using Engine = RuleEngine<Rules, ExploringController, SwapCheck>;
+    constexpr size_t CHUNK = 64;
+
+    RuleTables tables = base;
+    const int n = settings.numPlayers;
+    tables.initialCards = settings.cards;
+    tables.numberDeck = settings.numberDeck + n * settings.cards;  // settings.numberDeck is what is left
+    tables.initialActionDeck = settings.actionDeck;
+    unsigned threads = settings.threads ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // Distinct handlers only: SKIP and WILD share BLOCK's and COLOR's
+    std::vector<ActionType> actions;
+    for (ActionType t : {ActionType::BLOCK, ActionType::REVERSE, ActionType::COLOR_CHANGE, ActionType::DRAW_TWO,
+                         ActionType::DRAW_FOUR, ActionType::TRUTH, ActionType::DARE}) {
+        if (Engine::isPlayable(t)) actions.push_back(t);
+    }
+
+    const std::vector<std::vector<BidVector>> bidLists = representativeBids(tables, n);
+    ModelCheckResult result;
+    VisitedSet visited;
+    std::mutex reportMutex;
+
+    // Every split of starting action cards
+    std::vector<GameState> level;
+    std::array<int, MAX_PLAYERS> split{};
+    while (true) {
+        GameState s;
+        s.reset(tables, n);
+        for (int i = 0; i < n; ++i) s.actionCards[i] = split[i];
+        if (visited.insert(keyOf(s))) level.push_back(s);
+        int i = 0;
+        while (i < n && ++split[i] > settings.maxActionCards) split[i++] = 0;
+        if (i == n) break;
+    }
+    result.states = level.size();
+
+    auto report = [&](const GameState& before, const std::string& step, const std::string& decisions,
+                      const std::string& message) {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        ++result.violationCount;
+        if (result.violations.size() < settings.maxViolations) {
+            result.violations.push_back({before, step, decisions, message});
+        }
+    };
+
+    std::atomic<uint64_t> transitions{0};
+    while (!level.empty()) {
+        if (settings.maxDepth > 0 && result.depth == settings.maxDepth) break;
+        std::atomic<size_t> next{0};
+        std::vector<std::vector<GameState>> found(threads);
+
+        auto worker = [&](unsigned id) {
+            ExploringController ctl(bidLists);
+            SwapCheck swapCheck;
+            Engine engine(tables, ctl, swapCheck);
+            uint64_t runs = 0;
+
+            // Runs one step under every decision sequence
+            auto explore = [&](const GameState& before, int seat, ActionType type) {
+                bool numberRound = type == ActionType::UNKNOWN;
+                swapCheck.before = &before;
+                ctl.reset();
+                do {
+                    ctl.restart();
+                    swapCheck.error.clear();
+                    engine.restore(before, 0);
+                    if (numberRound) {
+                        engine.handleNumberRound();
+                    } else {
+                        engine.dispatchAction(seat, type);
+                    }
+                    ++runs;
+                    const GameState& after = engine.gameState();
+                    std::string error = ctl.overflowed() ? "too many decisions in one step" : swapCheck.error;
+                    if (error.empty()) error = checkStep(before, after, numberRound, tables);
+                    if (!error.empty()) {
+                        std::string step = numberRound ? std::string("number round")
+                                                       : "P" + std::to_string(seat + 1) + " plays " +
+                                                             ACTION_TOKENS[static_cast<int>(type)].text;
+                        report(before, step, ctl.describe(), error);
+                    } else if (visited.insert(keyOf(after))) {
+                        found[id].push_back(after);
+                    }
+                } while (ctl.advance());
+            };
+
+            while (true) {
+                size_t begin = next.fetch_add(CHUNK);
+                if (begin >= level.size()) break;
+                size_t end = std::min(level.size(), begin + CHUNK);
+                for (size_t k = begin; k < end; ++k) {
+                    const GameState& s = level[k];
+                    if (s.gameOver) continue;
+                    for (int seat = 0; seat < n; ++seat) {
+                        if (s.actionCards[seat] == 0) continue;
+                        for (ActionType t : actions) explore(s, seat, t);
+                    }
+                    explore(s, 0, ActionType::UNKNOWN);
+                }
+            }
+            transitions += runs;
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+
+        level.clear();
+        for (auto& part : found) level.insert(level.end(), part.begin(), part.end());
+        result.states += level.size();
+        if (!level.empty()) ++result.depth;
+    }
+    result.complete = level.empty();
+    result.transitions = transitions;
+    return result;
+}
+
+// Prints the report; true if no invariant was violated.
+template <typename Rules>
+bool printModelCheck(const RuleTables& base, const ModelCheckSettings& settings, std::ostream& out) {
+    auto start = std::chrono::steady_clock::now();
+    ModelCheckResult r = runModelCheck<Rules>(base, settings);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    out << "Model check: " << Rules::NAME << " rules, " << settings.numPlayers << " players, " << settings.cards
+        << " cards each, 0-" << settings.maxActionCards << " action cards, decks " << settings.numberDeck << "/"
+        << settings.actionDeck << "\n"
+        << "Explored " << r.states << " states and " << r.transitions << " transitions, " << r.depth << " steps deep"
+        << (r.complete ? "" : " (depth limit reached)") << ", in " << seconds << " s\n";
+    if (r.violationCount == 0) {
+        out << "No invariant violations.\n";
+        return true;
+    }
+    out << r.violationCount << " invariant violation(s); first " << r.violations.size() << ":\n";
+    for (const ModelViolation& v : r.violations) {
+        out << "  " << v.message << "\n"
+            << "    from:      " << model_check_detail::describeState(v.before) << "\n"
+            << "    step:      " << v.step << "\n"
+            << "    decisions: " << v.decisions << "\n";
+    }
+    return false;
+}
+
+#endif // SPLIT_UNO_MODEL_CHECK_H
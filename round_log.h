@@ -0,0 +1,326 @@
+/*******************************************************************************
+ * SPLIT UNO - ROUND LOG
+ *
+ * Columnar binary export of number rounds for balance analysis, plus a small
+ * reader. Rows are buffered column by column and written in large blocks, so
+ * a scan over one feature (e.g. every winner) reads one contiguous array per
+ * block instead of parsing a text log. Interactive hosts flush after every
+ * round instead, so a crash loses nothing; blocks may hold any row count.
+ *
+ * File layout (little-endian):
+ *   header:  "SURL" | u16 version | u8 numPlayers | u8 columnCount
+ *            columnCount x { u8 column id | u8 byte width | u8 per-player }
+ *   block:   "BLK1" | u32 rowCount
+ *            for each column in ROUND_COLUMNS order (per-player columns
+ *            repeated for each seat): rowCount x value
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_ROUND_LOG_H
+#define SPLIT_UNO_ROUND_LOG_H
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "game_state.h"
+
+enum class RoundColumn : uint8_t {
+    GAME,            // u32  game id within the file
+    ROUND,           // u32  number round within the game
+    WINNER,          // i8   winning seat, -1 on a tie or when everyone was blocked
+    TIE_MASK,        // u8   bit per seat that tied for the highest card
+    BID,             // i8   card played, -1 if blocked           (per player)
+    STEAL_TARGET,    // i8   seat stolen from, -1 if none          (per player)
+    PENALTY_TARGET,  // i8   seat given the penalty, -1 if none    (per player)
+    NUMBER_CARDS,    // i16  number cards after the round          (per player)
+    ACTION_CARDS,    // i16  action cards after the round          (per player)
+    STREAK,          // u8   consecutive wins after the round      (per player)
+    BLOCKED,         // u8   1 if the seat sat this round out      (per player)
+    NUMBER_DECK,     // i16  number deck remaining after the round
+    ACTION_DECK,     // i16  action deck remaining after the round
+    COUNT
+};
+
+struct RoundColumnSpec {
+    RoundColumn id;
+    uint8_t width;
+    bool perPlayer;
+};
+
+// Storage order: widest columns first so every column in a block is
+// naturally aligned for its type.
+constexpr RoundColumnSpec ROUND_COLUMNS[] = {
+    {RoundColumn::GAME,           4, false},
+    {RoundColumn::ROUND,          4, false},
+    {RoundColumn::NUMBER_CARDS,   2, true},
+    {RoundColumn::ACTION_CARDS,   2, true},
+    {RoundColumn::NUMBER_DECK,    2, false},
+    {RoundColumn::ACTION_DECK,    2, false},
+    {RoundColumn::WINNER,         1, false},
+    {RoundColumn::TIE_MASK,       1, false},
+    {RoundColumn::BID,            1, true},
+    {RoundColumn::STEAL_TARGET,   1, true},
+    {RoundColumn::PENALTY_TARGET, 1, true},
+    {RoundColumn::STREAK,         1, true},
+    {RoundColumn::BLOCKED,        1, true},
+};
+
+constexpr int NUM_ROUND_COLUMNS = static_cast<int>(RoundColumn::COUNT);
+constexpr uint16_t ROUND_LOG_VERSION = 1;
+constexpr uint32_t ROUND_LOG_BLOCK_ROWS = 65536;
+
+// One number round as seen at the end of its resolution.
+struct RoundRecord {
+    uint32_t game;
+    uint32_t round;
+    int8_t winner;
+    uint8_t tieMask;
+    std::array<int8_t, MAX_PLAYERS> bid;
+    std::array<int8_t, MAX_PLAYERS> stealTarget;
+    std::array<int8_t, MAX_PLAYERS> penaltyTarget;
+    std::array<int16_t, MAX_PLAYERS> numberCards;
+    std::array<int16_t, MAX_PLAYERS> actionCards;
+    std::array<uint8_t, MAX_PLAYERS> streak;
+    std::array<uint8_t, MAX_PLAYERS> blocked;
+    int16_t numberDeck;
+    int16_t actionDeck;
+};
+
+// Physical column layout shared by writer and reader: one slot per column,
+// numPlayers slots for per-player columns.
+class RoundLogLayout {
+public:
+    void build(int players) {
+        numPlayers = players;
+        int slot = 0;
+        rowBytes = 0;
+        for (const auto& spec : ROUND_COLUMNS) {
+            int idx = static_cast<int>(spec.id);
+            firstSlot[idx] = slot;
+            int copies = spec.perPlayer ? numPlayers : 1;
+            for (int p = 0; p < copies; ++p) {
+                slotWidth[slot] = spec.width;
+                slotOffset[slot] = rowBytes;  // Offset in units of block rows
+                rowBytes += spec.width;
+                ++slot;
+            }
+        }
+        numSlots = slot;
+    }
+
+    int slot(RoundColumn c, int player) const { return firstSlot[static_cast<int>(c)] + player; }
+
+    static constexpr int MAX_SLOTS = NUM_ROUND_COLUMNS * MAX_PLAYERS;
+    int numPlayers = 0;
+    int numSlots = 0;
+    uint32_t rowBytes = 0;
+    std::array<int, NUM_ROUND_COLUMNS> firstSlot{};
+    std::array<uint8_t, MAX_SLOTS> slotWidth{};
+    std::array<uint32_t, MAX_SLOTS> slotOffset{};
+};
+
+/*******************************************************************************
+ * WRITER
+ ******************************************************************************/
+
+class RoundLogWriter {
+public:
+    RoundLogWriter() = default;
+    RoundLogWriter(const RoundLogWriter&) = delete;
+    RoundLogWriter& operator=(const RoundLogWriter&) = delete;
+    ~RoundLogWriter() { close(); }
+
+    // Starts a new file, finishing the one already open first.
+    bool open(const std::string& path, int numPlayers, std::string& error) {
+        close();
+        ok = true;
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            error = "cannot create round log '" + path + "'";
+            return false;
+        }
+        layout.build(numPlayers);
+        block.assign(static_cast<size_t>(layout.rowBytes) * ROUND_LOG_BLOCK_ROWS, 0);
+        rows = 0;
+
+        uint8_t header[8] = {'S', 'U', 'R', 'L', 0, 0, static_cast<uint8_t>(numPlayers),
+                             static_cast<uint8_t>(NUM_ROUND_COLUMNS)};
+        std::memcpy(header + 4, &ROUND_LOG_VERSION, 2);
+        writeBytes(header, sizeof(header));
+        for (const auto& spec : ROUND_COLUMNS) {
+            uint8_t desc[3] = {static_cast<uint8_t>(spec.id), spec.width, spec.perPlayer};
+            writeBytes(desc, sizeof(desc));
+        }
+        return ok;
+    }
+
+    void record(const RoundRecord& r) {
+        put(RoundColumn::GAME, 0, &r.game);
+        put(RoundColumn::ROUND, 0, &r.round);
+        put(RoundColumn::WINNER, 0, &r.winner);
+        put(RoundColumn::TIE_MASK, 0, &r.tieMask);
+        for (int p = 0; p < layout.numPlayers; ++p) {
+            put(RoundColumn::BID, p, &r.bid[p]);
+            put(RoundColumn::STEAL_TARGET, p, &r.stealTarget[p]);
+            put(RoundColumn::PENALTY_TARGET, p, &r.penaltyTarget[p]);
+            put(RoundColumn::NUMBER_CARDS, p, &r.numberCards[p]);
+            put(RoundColumn::ACTION_CARDS, p, &r.actionCards[p]);
+            put(RoundColumn::STREAK, p, &r.streak[p]);
+            put(RoundColumn::BLOCKED, p, &r.blocked[p]);
+        }
+        put(RoundColumn::NUMBER_DECK, 0, &r.numberDeck);
+        put(RoundColumn::ACTION_DECK, 0, &r.actionDeck);
+        if (++rows == ROUND_LOG_BLOCK_ROWS) flush();
+    }
+
+    // Writes the buffered rows as one block and hands it to the OS.
+    void flush() {
+        if (!file || rows == 0) return;
+        uint8_t header[8] = {'B', 'L', 'K', '1'};
+        std::memcpy(header + 4, &rows, 4);
+        writeBytes(header, sizeof(header));
+        if (rows == ROUND_LOG_BLOCK_ROWS) {
+            writeBytes(block.data(), block.size());
+        } else {
+            for (int s = 0; s < layout.numSlots; ++s) {
+                writeBytes(block.data() + static_cast<size_t>(layout.slotOffset[s]) * ROUND_LOG_BLOCK_ROWS,
+                           static_cast<size_t>(layout.slotWidth[s]) * rows);
+            }
+        }
+        rows = 0;
+        if (std::fflush(file) != 0) ok = false;
+    }
+
+    void close() {
+        if (!file) return;
+        flush();
+        if (std::fclose(file) != 0) ok = false;
+        file = nullptr;
+    }
+
+    bool isOpen() const { return file != nullptr; }
+    bool good() const { return ok; }
+    int numPlayers() const { return layout.numPlayers; }
+
+private:
+    std::FILE* file = nullptr;
+    bool ok = true;
+    RoundLogLayout layout;
+    std::vector<uint8_t> block;  // Column-major: each slot owns BLOCK_ROWS values
+    uint32_t rows = 0;
+
+    void put(RoundColumn c, int player, const void* value) {
+        int s = layout.slot(c, player);
+        std::memcpy(block.data() + static_cast<size_t>(layout.slotOffset[s]) * ROUND_LOG_BLOCK_ROWS +
+                        static_cast<size_t>(layout.slotWidth[s]) * rows,
+                    value, layout.slotWidth[s]);
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        if (std::fwrite(data, 1, size, file) != size) ok = false;
+    }
+};
+
+/*******************************************************************************
+ * READER
+ *
+ * Usage:
+ *   RoundLogReader log;
+ *   if (!log.open("rounds.surl", error)) ...
+ *   while (log.nextBlock()) {
+ *       const int8_t* winner = log.column<int8_t>(RoundColumn::WINNER);
+ *       for (uint32_t r = 0; r < log.rows(); ++r) ...
+ *   }
+ ******************************************************************************/
+
+class RoundLogReader {
+public:
+    RoundLogReader() = default;
+    RoundLogReader(const RoundLogReader&) = delete;
+    RoundLogReader& operator=(const RoundLogReader&) = delete;
+    ~RoundLogReader() { close(); }
+
+    // Opens a log and checks its header, closing the one already open first.
+    // On failure no file is left open.
+    bool open(const std::string& path, std::string& error) {
+        close();
+        file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            error = "cannot open round log '" + path + "'";
+            return false;
+        }
+        uint8_t header[8];
+        uint16_t version = 0;
+        if (std::fread(header, 1, sizeof(header), file) != sizeof(header) ||
+            std::memcmp(header, "SURL", 4) != 0) {
+            return fail("'" + path + "' is not a round log", error);
+        }
+        std::memcpy(&version, header + 4, 2);
+        if (version != ROUND_LOG_VERSION) {
+            return fail("unsupported round log version " + std::to_string(version), error);
+        }
+        int players = header[6];
+        if (players < MIN_PLAYERS || players > MAX_PLAYERS || header[7] != NUM_ROUND_COLUMNS) {
+            return fail("corrupt round log header", error);
+        }
+        for (const auto& spec : ROUND_COLUMNS) {
+            uint8_t desc[3];
+            if (std::fread(desc, 1, sizeof(desc), file) != sizeof(desc) ||
+                desc[0] != static_cast<uint8_t>(spec.id) || desc[1] != spec.width ||
+                desc[2] != static_cast<uint8_t>(spec.perPlayer)) {
+                return fail("round log columns do not match this reader", error);
+            }
+        }
+        layout.build(players);
+        return true;
+    }
+
+    // Loads the next block with one read; false at end of file or on a
+    // truncated block.
+    bool nextBlock() {
+        uint8_t header[8];
+        if (!file || std::fread(header, 1, sizeof(header), file) != sizeof(header) ||
+            std::memcmp(header, "BLK1", 4) != 0) {
+            return false;
+        }
+        std::memcpy(&blockRows, header + 4, 4);
+        if (blockRows == 0 || blockRows > ROUND_LOG_BLOCK_ROWS) return false;
+        block.resize(static_cast<size_t>(layout.rowBytes) * blockRows);
+        if (std::fread(block.data(), 1, block.size(), file) != block.size()) return false;
+        return true;
+    }
+
+    void close() {
+        if (file) std::fclose(file);
+        file = nullptr;
+        blockRows = 0;
+    }
+
+    int numPlayers() const { return layout.numPlayers; }
+    uint32_t rows() const { return blockRows; }
+
+    // Contiguous values of one column in the current block. T must match
+    // the column width (see RoundColumn).
+    template <typename T>
+    const T* column(RoundColumn c, int player = 0) const {
+        int s = layout.slot(c, player);
+        return reinterpret_cast<const T*>(block.data() + static_cast<size_t>(layout.slotOffset[s]) * blockRows);
+    }
+
+private:
+    std::FILE* file = nullptr;
+    RoundLogLayout layout;
+    std::vector<uint8_t> block;
+    uint32_t blockRows = 0;
+
+    bool fail(const std::string& message, std::string& error) {
+        close();
+        error = message;
+        return false;
+    }
+};
+
+#endif // SPLIT_UNO_ROUND_LOG_H
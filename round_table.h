@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * SPLIT UNO - ROUND OUTCOME TABLES
+ *
+ * In a 2-player game every target is the opponent, so a number round is
+ * fully determined by the two bids: who wins, what each card steals or
+ * forces the other to draw, who sheds and draws, and what happens to the
+ * streaks. This header enumerates all bid pairs into a table once (at
+ * compile time for the built-in variants) so bulk evaluation - simulations,
+ * search, hints - resolves a round with one indexed load and a few
+ * saturating adds instead of the branchy logic in RuleEngine.
+ *
+ * Only the deck and hand limits depend on the state; applyRoundOutcome
+ * clamps them in the same order as RuleEngine::handleNumberRound. The
+ * streak bonus and the win check ask for decisions and stay with the
+ * caller.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_ROUND_TABLE_H
+#define SPLIT_UNO_ROUND_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "game_state.h"
+#include "rules.h"
+
+// Bid slots: the cards 0-9 plus one for a blocked seat
+constexpr int BLOCKED_BID = NUM_CARD_VALUES;
+constexpr int NUM_BID_SLOTS = NUM_CARD_VALUES + 1;
+
+// Effect of one 2-player number round, indexed by seat
+struct RoundOutcome {
+    int8_t winner;                    // Seat, NO_WINNER on a tie or when both are blocked
+    uint8_t tie;                      // 1 = both played the top card
+    uint8_t steal[2];                 // Cards seat i steals from the other (capped by their hand)
+    uint8_t penaltyNumber[2];         // Number cards the other seat draws from seat i's card
+    uint8_t penaltyAction[2];         // Action cards the other seat draws from seat i's card
+    uint8_t shed[2];                  // Cards shed after the effects (floored at 0)
+    uint8_t draw[2];                  // Number cards drawn after shedding
+    uint8_t streakKeep[2];            // 1 keeps the streak, 0 resets it
+    uint8_t streakAdd[2];             // Added after streakKeep
+    uint8_t resolved;                 // 0 if both were blocked (no streak bonus or win check)
+};
+
+class RoundOutcomeTable {
+public:
+    // Bids are 0-9, or NO_CARD / BLOCKED_BID for a blocked seat.
+    constexpr const RoundOutcome& operator()(int bid0, int bid1) const {
+        return entries[slot(bid0) * NUM_BID_SLOTS + slot(bid1)];
+    }
+
+    static constexpr RoundOutcomeTable build(const RuleTables& t) {
+        RoundOutcomeTable table{};
+        for (int a = 0; a < NUM_BID_SLOTS; ++a) {
+            for (int b = 0; b < NUM_BID_SLOTS; ++b) {
+                table.entries[a * NUM_BID_SLOTS + b] = resolve(t, a, b);
+            }
+        }
+        return table;
+    }
+
+private:
+    std::array<RoundOutcome, NUM_BID_SLOTS * NUM_BID_SLOTS> entries{};
+
+    static constexpr int slot(int bid) { return bid == NO_CARD ? BLOCKED_BID : bid; }
+
+    static constexpr RoundOutcome resolve(const RuleTables& t, int a, int b) {
+        RoundOutcome o{};
+        const int bids[2] = {a, b};
+        const bool played[2] = {a != BLOCKED_BID, b != BLOCKED_BID};
+        o.winner = NO_WINNER;
+        for (int i = 0; i < 2; ++i) o.streakKeep[i] = 1;
+
+        for (int i = 0; i < 2; ++i) {
+            if (!played[i]) continue;
+            o.steal[i] = static_cast<uint8_t>(t.bidSteal[bids[i]]);
+            o.penaltyNumber[i] = static_cast<uint8_t>(t.bidPenaltyNumber[bids[i]]);
+            o.penaltyAction[i] = static_cast<uint8_t>(t.bidPenaltyAction[bids[i]]);
+        }
+
+        if (!played[0] && !played[1]) return o;
+        o.resolved = 1;
+
+        if (played[0] && played[1] && a == b) {
+            o.tie = 1;
+            for (int i = 0; i < 2; ++i) {
+                o.shed[i] = static_cast<uint8_t>(t.tieShed);
+                o.draw[i] = static_cast<uint8_t>(t.tieDraw);
+                o.streakKeep[i] = static_cast<uint8_t>(t.tieStreakKeep);
+            }
+            return o;
+        }
+
+        // A blocked seat counts as lower than any card but neither loses nor draws
+        int w = !played[1] || (played[0] && a > b) ? 0 : 1;
+        int l = 1 - w;
+        o.winner = static_cast<int8_t>(w);
+        o.shed[w] = static_cast<uint8_t>(t.winnerShed);
+        o.streakAdd[w] = 1;
+        if (played[l]) {
+            o.draw[l] = static_cast<uint8_t>(t.loserDraw);
+            o.streakKeep[l] = 0;
+        }
+        return o;
+    }
+};
+
+// Outcome table of a built-in variant with its default house rules
+template <typename Rules>
+inline constexpr RoundOutcomeTable ROUND_OUTCOMES = RoundOutcomeTable::build(defaultRuleTables<Rules>());
+
+// Cards actually taken from a deck (the deck may run short)
+inline int takeFromDeck(int& deck, int amount) {
+    int taken = std::min(amount, std::max(deck, 0));
+    deck -= taken;
+    return taken;
+}
+
+// Applies a looked-up round to a 2-player state, clamping steals to the
+// victim's hand and draws to the decks in RuleEngine order.
+inline void applyRoundOutcome(GameState& s, const RoundOutcome& o) {
+    for (int i = 0; i < 2; ++i) {
+        int other = 1 - i;
+        int stolen = std::min<int>(o.steal[i], s.numberCards[other]);
+        s.numberCards[i] += stolen;
+        s.numberCards[other] -= stolen;
+        s.numberCards[other] += takeFromDeck(s.numberDeckRemaining, o.penaltyNumber[i]);
+        s.actionCards[other] += takeFromDeck(s.actionDeckRemaining, o.penaltyAction[i]);
+    }
+    for (int i = 0; i < 2; ++i) {
+        s.numberCards[i] = std::max(0, s.numberCards[i] - o.shed[i]);
+        s.consecutiveWins[i] = s.consecutiveWins[i] * o.streakKeep[i] + o.streakAdd[i];
+    }
+    for (int i = 0; i < 2; ++i) {
+        s.numberCards[i] += takeFromDeck(s.numberDeckRemaining, o.draw[i]);
+    }
+    s.blocked[0] = 0;
+    s.blocked[1] = 0;
+}
+
+static_assert(ROUND_OUTCOMES<StandardRules>(9, 3).winner == 0, "higher card wins");
+static_assert(ROUND_OUTCOMES<StandardRules>(0, NO_CARD).winner == 0, "a blocked seat cannot win");
+static_assert(ROUND_OUTCOMES<StandardRules>(7, 7).tie == 1, "equal cards tie");
+static_assert(ROUND_OUTCOMES<StandardRules>(0, 5).steal[0] == StandardRules::CARD_0_DRAW, "card 0 steals");
+
+#endif // SPLIT_UNO_ROUND_TABLE_H
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ * SPLIT UNO - RULE EVENTS
+ *
+ * One plain struct per rule outcome, delivered by the rule engine to the
+ * observers it was instantiated with (RuleEngine<Rules, Controller,
+ * Observers...>). An observer is any class with a member
+ *
+ *   void on(const Event&, const GameState& after)
+ *
+ * for each event it cares about; events it has no overload for are skipped
+ * at compile time. Observers are held by reference and called directly, so
+ * there is no virtual dispatch, and an engine without observers generates
+ * the same code as before the hooks existed.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_RULE_EVENTS_H
+#define SPLIT_UNO_RULE_EVENTS_H
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "game_state.h"
+
+// Number round: a single seat played the highest card
+struct RoundWon {
+    int winner;
+    int card;
+};
+
+// Number round: several seats played the highest card
+struct RoundTied {
+    int card;
+    uint8_t tieMask;  // Bit per tied seat
+};
+
+// Card 0 (or the house-rule steal card)
+struct CardsStolen {
+    int player;
+    int target;
+    int stolen;  // May be fewer than the rule allows if the target ran short
+};
+
+// Card 7 (or the house-rule penalty card)
+struct PenaltyDrawn {
+    int player;
+    int target;
+    int numberDrawn;
+    int actionDrawn;
+};
+
+struct BlockPlayed {
+    int player;
+    int target;
+    bool countered;
+};
+
+struct HandsSwapped {
+    int player;
+    int target;
+};
+
+struct ColorChanged {
+    int player;
+    int color;
+};
+
+// +2/+4, with the target's counter if any
+struct DrawAttack {
+    int player;
+    int target;
+    int amount;
+    int counter;  // 0, 2 or 4
+    int loser;    // Seat that drew, NO_WINNER when the counter tied
+    int drawn;    // Cards the loser drew from the deck; 0 on a tie
+};
+
+struct TruthResolved {
+    int player;
+    int target;
+    bool answered;
+    int penalty;  // TRUTH_PENALTY choice, 0 if answered
+};
+
+struct DareResolved {
+    int player;
+    int target;
+    bool completed;  // false ends the game for player
+};
+
+// Consecutive-wins bonus
+struct BonusTaken {
+    int player;
+    int choice;  // 1 = draw action cards, 2 = opponents draw
+};
+
+// A player reached 0 cards; challenger is NO_CHALLENGE if nobody challenged
+struct ChallengeResolved {
+    int winner;
+    int challenger;
+    int amount;  // 2 or 4; 0 without a challenge
+};
+
+template <typename Observer, typename Event, typename = void>
+struct HandlesRuleEvent : std::false_type {};
+
+template <typename Observer, typename Event>
+struct HandlesRuleEvent<Observer, Event,
+                        std::void_t<decltype(std::declval<Observer&>().on(std::declval<const Event&>(),
+                                                                          std::declval<const GameState&>()))>>
+    : std::true_type {};
+
+// The observers of one engine; empty, and every notify() a no-op, without any.
+template <typename... Observers>
+class RuleObservers {
+public:
+    explicit RuleObservers(Observers&... observers) : list(observers...) {}
+
+    template <typename Event>
+    void notify(const Event& event, const GameState& after) {
+        std::apply([&](auto&... observer) { (deliver(observer, event, after), ...); }, list);
+    }
+
+private:
+    std::tuple<Observers&...> list;
+
+    template <typename Observer, typename Event>
+    static void deliver(Observer& observer, const Event& event, const GameState& after) {
+        if constexpr (HandlesRuleEvent<Observer, Event>::value) observer.on(event, after);
+    }
+};
+
+template <>
+class RuleObservers<> {
+public:
+    template <typename Event>
+    void notify(const Event&, const GameState&) {}
+};
+
+/*******************************************************************************
+ * EVENT COUNTS
+ *
+ * Observer that tallies every event; per-thread counts merge exactly.
+ ******************************************************************************/
+
+struct RuleEventCounts {
+    uint64_t roundsWon = 0;
+    uint64_t ties = 0;
+    uint64_t steals = 0;
+    uint64_t cardsStolen = 0;
+    uint64_t penalties = 0;
+    uint64_t blocks = 0;
+    uint64_t blocksCountered = 0;
+    uint64_t swaps = 0;
+    uint64_t colorChanges = 0;
+    uint64_t drawAttacks = 0;
+    uint64_t drawsCountered = 0;
+    uint64_t truths = 0;
+    uint64_t truthsRefused = 0;
+    uint64_t dares = 0;
+    uint64_t daresForfeited = 0;
+    uint64_t bonuses = 0;
+    uint64_t challenges = 0;  // Accepted challenges only
+
+    void on(const RoundWon&, const GameState&) { ++roundsWon; }
+    void on(const RoundTied&, const GameState&) { ++ties; }
+    void on(const CardsStolen& e, const GameState&) {
+        ++steals;
+        cardsStolen += static_cast<uint64_t>(e.stolen);
+    }
+    void on(const PenaltyDrawn&, const GameState&) { ++penalties; }
+    void on(const BlockPlayed& e, const GameState&) {
+        ++blocks;
+        blocksCountered += e.countered;
+    }
+    void on(const HandsSwapped&, const GameState&) { ++swaps; }
+    void on(const ColorChanged&, const GameState&) { ++colorChanges; }
+    void on(const DrawAttack& e, const GameState&) {
+        ++drawAttacks;
+        drawsCountered += e.counter != 0;
+    }
+    void on(const TruthResolved& e, const GameState&) {
+        ++truths;
+        truthsRefused += !e.answered;
+    }
+    void on(const DareResolved& e, const GameState&) {
+        ++dares;
+        daresForfeited += !e.completed;
+    }
+    void on(const BonusTaken&, const GameState&) { ++bonuses; }
+    void on(const ChallengeResolved& e, const GameState&) { challenges += e.challenger >= 0; }
+
+    void merge(const RuleEventCounts& o) {
+        roundsWon += o.roundsWon;
+        ties += o.ties;
+        steals += o.steals;
+        cardsStolen += o.cardsStolen;
+        penalties += o.penalties;
+        blocks += o.blocks;
+        blocksCountered += o.blocksCountered;
+        swaps += o.swaps;
+        colorChanges += o.colorChanges;
+        drawAttacks += o.drawAttacks;
+        drawsCountered += o.drawsCountered;
+        truths += o.truths;
+        truthsRefused += o.truthsRefused;
+        dares += o.dares;
+        daresForfeited += o.daresForfeited;
+        bonuses += o.bonuses;
+        challenges += o.challenges;
+    }
+};
+
+#endif // SPLIT_UNO_RULE_EVENTS_H
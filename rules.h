@@ -0,0 +1,296 @@
+/*******************************************************************************
+ * SPLIT UNO - RULES
+ *
+ * Compile-time rule variants and runtime house-rule configuration.
+ *
+ * Variants (Standard, Speed, Hardcore) are policies: the arbiter is
+ * instantiated once per variant, so switches that are off are removed from
+ * that build entirely instead of being checked at runtime.
+ *
+ * House rules are numeric parameters (starting cards, penalty sizes, tie
+ * behaviour, ...) read from a config file at startup. The file is validated
+ * once and flattened into an immutable RuleTables that the game loop reads
+ * by index.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_RULES_H
+#define SPLIT_UNO_RULES_H
+
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+/*******************************************************************************
+ * RULE VARIANTS
+ ******************************************************************************/
+
+// Official rules (see ruleset.md)
+struct StandardRules {
+    static constexpr const char* NAME = "Standard";
+    static constexpr int INITIAL_CARDS = 20;              // Starting number cards per player
+    static constexpr int NUMBER_DECK = 108;               // Number cards before dealing
+    static constexpr int INITIAL_ACTION_DECK = 32;        // Action cards available
+    static constexpr int CONSECUTIVE_WINS_THRESHOLD = 2;  // Wins needed for bonus
+    static constexpr int MAX_CARD_NUMBER = 9;             // Highest number card
+    static constexpr int MIN_CARD_NUMBER = 0;             // Lowest number card
+    static constexpr int CARD_0_DRAW = 1;                 // Cards stolen by playing 0
+    static constexpr int CARD_7_NUMBER_DRAW = 2;          // Number cards from card 7
+    static constexpr int CARD_7_ACTION_DRAW = 1;          // Action cards from card 7
+    static constexpr int WINNER_SHED = 1;                 // Cards shed by the round winner
+    static constexpr int LOSER_DRAW = 1;                  // Cards drawn by each loser
+    static constexpr int TIE_SHED = 1;                    // Cards shed by each tied player
+    static constexpr int TIE_DRAW = 1;                    // Cards drawn by everyone on a tie
+    static constexpr int TIE_RESETS_STREAK = 1;           // Tie resets consecutive wins
+    static constexpr int BONUS_ACTION_DRAW = 1;           // Streak bonus option 1
+    static constexpr int BONUS_OPPONENT_DRAW = 2;         // Streak bonus option 2
+    static constexpr int TRUTH_PENALTY_A_ATTACKER_ACTION = 2;
+    static constexpr int TRUTH_PENALTY_A_TARGET_NUMBER = 2;
+    static constexpr int TRUTH_PENALTY_B_TARGET_NUMBER = 5;
+    static constexpr bool TRUTH_DARE_ENABLED = true;      // TRUTH/DARE cards in play
+    static constexpr bool COUNTERS_ENABLED = true;        // +2/+4 may be countered
+    static constexpr bool CHALLENGES_ENABLED = true;      // Challenges allowed at 0 cards
+};
+
+// Speed UNO: 15 starting cards, no TRUTH/DARE
+struct SpeedRules : StandardRules {
+    static constexpr const char* NAME = "Speed";
+    static constexpr int INITIAL_CARDS = 15;
+    static constexpr bool TRUTH_DARE_ENABLED = false;
+};
+
+// Hardcore Mode: no challenges at 0 cards, +2/+4 cannot be countered
+struct HardcoreRules : StandardRules {
+    static constexpr const char* NAME = "Hardcore";
+    static constexpr bool COUNTERS_ENABLED = false;
+    static constexpr bool CHALLENGES_ENABLED = false;
+};
+
+/*******************************************************************************
+ * HOUSE RULES
+ ******************************************************************************/
+
+constexpr int NUM_CARD_VALUES = 10;  // Number cards 0-9
+
+// Flattened, read-only rule parameters used by the game loop.
+// Per-card effects are indexed by the bid, penalties by the menu choice.
+struct RuleTables {
+    int initialCards;
+    int numberDeck;                                   // Number cards before dealing
+    int initialActionDeck;
+    int consecutiveWinsThreshold;
+
+    // Number round
+    int winnerShed;                                   // Cards shed by the round winner
+    int loserDraw;                                    // Cards drawn by each loser
+    int tieShed;                                      // Cards shed by each tied player
+    int tieDraw;                                      // Cards drawn by every player on a tie
+    int tieStreakKeep;                                // 1 = tie keeps streaks, 0 = tie resets them
+    std::array<int, NUM_CARD_VALUES> bidSteal;        // Cards stolen by playing this card
+    std::array<int, NUM_CARD_VALUES> bidPenaltyNumber; // Number cards the target draws
+    std::array<int, NUM_CARD_VALUES> bidPenaltyAction; // Action cards the target draws
+
+    // Consecutive wins bonus
+    int bonusActionDraw;                              // Option 1: bonus action cards
+    int bonusOpponentDraw;                            // Option 2: number cards per opponent
+
+    // TRUTH refusal, indexed by penalty choice (1 or 2; 0 unused)
+    std::array<int, 3> truthAttackerAction;
+    std::array<int, 3> truthTargetNumber;
+
+    // Number cards left in the deck once players have been dealt their
+    // hands; a table dealt from more cards than the deck holds starts empty.
+    constexpr int numberDeckAfterDeal(int players) const {
+        int left = numberDeck - players * initialCards;
+        return left > 0 ? left : 0;
+    }
+};
+
+// One field per config key. Defaults come from the compile-time variant so
+// a config only lists the rules it changes.
+struct RuleValues {
+    int initialCards;
+    int numberDeck;
+    int initialActionDeck;
+    int consecutiveWinsThreshold;
+    int card0Draw;
+    int card7NumberDraw;
+    int card7ActionDraw;
+    int winnerShed;
+    int loserDraw;
+    int tieShed;
+    int tieDraw;
+    int tieResetsStreak;
+    int bonusActionDraw;
+    int bonusOpponentDraw;
+    int truthPenaltyAAttackerAction;
+    int truthPenaltyATargetNumber;
+    int truthPenaltyBTargetNumber;
+
+    template <typename Rules>
+    static constexpr RuleValues defaults() {
+        return {Rules::INITIAL_CARDS, Rules::NUMBER_DECK, Rules::INITIAL_ACTION_DECK,
+                Rules::CONSECUTIVE_WINS_THRESHOLD, Rules::CARD_0_DRAW, Rules::CARD_7_NUMBER_DRAW,
+                Rules::CARD_7_ACTION_DRAW, Rules::WINNER_SHED, Rules::LOSER_DRAW, Rules::TIE_SHED,
+                Rules::TIE_DRAW, Rules::TIE_RESETS_STREAK, Rules::BONUS_ACTION_DRAW,
+                Rules::BONUS_OPPONENT_DRAW, Rules::TRUTH_PENALTY_A_ATTACKER_ACTION,
+                Rules::TRUTH_PENALTY_A_TARGET_NUMBER, Rules::TRUTH_PENALTY_B_TARGET_NUMBER};
+    }
+
+    constexpr RuleTables tables() const {
+        RuleTables t{};
+        t.initialCards = initialCards;
+        t.numberDeck = numberDeck;
+        t.initialActionDeck = initialActionDeck;
+        t.consecutiveWinsThreshold = consecutiveWinsThreshold;
+
+        t.winnerShed = winnerShed;
+        t.loserDraw = loserDraw;
+        t.tieShed = tieShed;
+        t.tieDraw = tieDraw;
+        t.tieStreakKeep = 1 - tieResetsStreak;
+        t.bidSteal[0] = card0Draw;
+        t.bidPenaltyNumber[7] = card7NumberDraw;
+        t.bidPenaltyAction[7] = card7ActionDraw;
+
+        t.bonusActionDraw = bonusActionDraw;
+        t.bonusOpponentDraw = bonusOpponentDraw;
+
+        t.truthAttackerAction[1] = truthPenaltyAAttackerAction;
+        t.truthTargetNumber[1] = truthPenaltyATargetNumber;
+        t.truthTargetNumber[2] = truthPenaltyBTargetNumber;
+        return t;
+    }
+};
+
+// Tables for a variant without a config file, usable in constant expressions
+template <typename Rules>
+constexpr RuleTables defaultRuleTables() {
+    return RuleValues::defaults<Rules>().tables();
+}
+
+// House-rule values addressed by their config-file names.
+class RuleConfig {
+public:
+    struct Entry {
+        int RuleValues::*field;
+        int min;
+        int max;
+    };
+
+    template <typename Rules>
+    static RuleConfig defaults() {
+        RuleConfig c;
+        c.values = RuleValues::defaults<Rules>();
+        return c;
+    }
+
+    // Applies "KEY = value" lines from a file ('#' starts a comment).
+    // Unknown keys, duplicates, non-integers and out-of-range values are
+    // rejected with a message naming the line.
+    bool loadFile(const std::string& path, std::string& error) {
+        std::ifstream in(path);
+        if (!in) {
+            error = "cannot open rules file '" + path + "'";
+            return false;
+        }
+
+        std::map<std::string, int> seen;
+        std::string line;
+        int lineNo = 0;
+        while (std::getline(in, line)) {
+            ++lineNo;
+            std::string where = path + ":" + std::to_string(lineNo) + ": ";
+
+            size_t hash = line.find('#');
+            if (hash != std::string::npos) line.erase(hash);
+            if (trim(line).empty()) continue;
+
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) {
+                error = where + "expected KEY = value";
+                return false;
+            }
+            std::string key = trim(line.substr(0, eq));
+            std::string text = trim(line.substr(eq + 1));
+            for (auto& ch : key) ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+
+            if (seen.count(key)) {
+                error = where + "'" + key + "' already set on line " + std::to_string(seen[key]);
+                return false;
+            }
+            seen[key] = lineNo;
+
+            std::istringstream parse(text);
+            int value;
+            char extra;
+            if (!KEYS.count(key)) {
+                error = where + "unknown rule '" + key + "'";
+                return false;
+            }
+            if (!(parse >> value) || (parse >> extra)) {
+                error = where + "'" + key + "' needs an integer value";
+                return false;
+            }
+            if (!set(key, value, error)) {
+                error = where + error;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Sets one rule after checking its key and range.
+    bool set(const std::string& key, int value, std::string& error) {
+        auto it = KEYS.find(key);
+        if (it == KEYS.end()) {
+            error = "unknown rule '" + key + "'";
+            return false;
+        }
+        if (value < it->second.min || value > it->second.max) {
+            error = "'" + key + "' must be between " + std::to_string(it->second.min) +
+                    " and " + std::to_string(it->second.max);
+            return false;
+        }
+        values.*(it->second.field) = value;
+        return true;
+    }
+
+    int get(const std::string& key) const { return values.*(KEYS.at(key).field); }
+
+    RuleTables tables() const { return values.tables(); }
+
+private:
+    RuleValues values{};
+
+    inline static const std::map<std::string, Entry> KEYS = {
+        {"INITIAL_CARDS",                   {&RuleValues::initialCards, 1, 100}},
+        {"NUMBER_DECK",                     {&RuleValues::numberDeck, 0, 1000}},
+        {"INITIAL_ACTION_DECK",             {&RuleValues::initialActionDeck, 0, 500}},
+        {"CONSECUTIVE_WINS_THRESHOLD",      {&RuleValues::consecutiveWinsThreshold, 1, 20}},
+        {"CARD_0_DRAW",                     {&RuleValues::card0Draw, 0, 20}},
+        {"CARD_7_NUMBER_DRAW",              {&RuleValues::card7NumberDraw, 0, 20}},
+        {"CARD_7_ACTION_DRAW",              {&RuleValues::card7ActionDraw, 0, 20}},
+        {"WINNER_SHED",                     {&RuleValues::winnerShed, 0, 20}},
+        {"LOSER_DRAW",                      {&RuleValues::loserDraw, 0, 20}},
+        {"TIE_SHED",                        {&RuleValues::tieShed, 0, 20}},
+        {"TIE_DRAW",                        {&RuleValues::tieDraw, 0, 20}},
+        {"TIE_RESETS_STREAK",               {&RuleValues::tieResetsStreak, 0, 1}},
+        {"BONUS_ACTION_DRAW",               {&RuleValues::bonusActionDraw, 0, 20}},
+        {"BONUS_OPPONENT_DRAW",             {&RuleValues::bonusOpponentDraw, 0, 20}},
+        {"TRUTH_PENALTY_A_ATTACKER_ACTION", {&RuleValues::truthPenaltyAAttackerAction, 0, 20}},
+        {"TRUTH_PENALTY_A_TARGET_NUMBER",   {&RuleValues::truthPenaltyATargetNumber, 0, 20}},
+        {"TRUTH_PENALTY_B_TARGET_NUMBER",   {&RuleValues::truthPenaltyBTargetNumber, 0, 20}},
+    };
+
+    static std::string trim(const std::string& s) {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        if (b == std::string::npos) return "";
+        size_t e = s.find_last_not_of(" \t\r\n");
+        return s.substr(b, e - b + 1);
+    }
+};
+
+#endif // SPLIT_UNO_RULES_H
@@ -0,0 +1,206 @@
+/*******************************************************************************
+ * SPLIT UNO - SAVED GAMES
+ *
+ * Small versioned binary snapshot of an in-progress game: names, card
+ * counts, streaks, blocks, deck remainders and the game-over flag. Saving
+ * writes a temporary file and renames it over the target, so a crash leaves
+ * either the old save or the new one, never a torn file. Loading is one
+ * read of the whole file followed by in-memory checks.
+ *
+ * File layout (little-endian):
+ *   "SUSV" | u16 version | u8 numPlayers | u8 gameOver | i8 winner | u8 0 | u16 0
+ *   u32 rules fingerprint | u32 rounds played | i32 number deck | i32 action deck
+ *   numPlayers x i32 number cards, i32 action cards, i32 streak, u8 blocked
+ *   numPlayers x { u8 length | name bytes }
+ *   u32 FNV-1a of everything above
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_SAVE_GAME_H
+#define SPLIT_UNO_SAVE_GAME_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "game_state.h"
+#include "rules.h"
+
+constexpr uint16_t SAVE_GAME_VERSION = 1;
+constexpr size_t MAX_SAVE_BYTES = 4096;  // Far above 6 players with 255-byte names
+
+struct SavedGame {
+    GameState state;
+    uint32_t rounds;
+    std::vector<std::string> names;
+};
+
+inline uint32_t fnv1a(const void* data, size_t size, uint32_t hash = 2166136261u) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+// Identifies variant plus house rules; a save only loads under the same ones.
+template <typename Rules>
+uint32_t rulesFingerprint(const RuleTables& tables) {
+    return fnv1a(&tables, sizeof(tables), fnv1a(Rules::NAME, std::strlen(Rules::NAME)));
+}
+
+namespace save_detail {
+
+template <typename T>
+void put(std::vector<uint8_t>& buf, T value) {
+    size_t at = buf.size();
+    buf.resize(at + sizeof(T));
+    std::memcpy(buf.data() + at, &value, sizeof(T));
+}
+
+// Bounds-checked cursor over the loaded bytes
+struct Cursor {
+    const std::vector<uint8_t>& buf;
+    size_t at;
+    bool ok;
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (at + sizeof(T) > buf.size()) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, buf.data() + at, sizeof(T));
+        at += sizeof(T);
+        return value;
+    }
+};
+
+}  // namespace save_detail
+
+inline bool saveGame(const std::string& path, const SavedGame& game, uint32_t rulesId, std::string& error) {
+    using save_detail::put;
+    const GameState& s = game.state;
+    std::vector<uint8_t> buf = {'S', 'U', 'S', 'V'};
+    put<uint16_t>(buf, SAVE_GAME_VERSION);
+    put<uint8_t>(buf, static_cast<uint8_t>(s.numPlayers));
+    put<uint8_t>(buf, s.gameOver);
+    put<int8_t>(buf, static_cast<int8_t>(s.winner));
+    put<uint8_t>(buf, 0);
+    put<uint16_t>(buf, 0);
+    put<uint32_t>(buf, rulesId);
+    put<uint32_t>(buf, game.rounds);
+    put<int32_t>(buf, s.numberDeckRemaining);
+    put<int32_t>(buf, s.actionDeckRemaining);
+    for (int i = 0; i < s.numPlayers; ++i) {
+        put<int32_t>(buf, s.numberCards[i]);
+        put<int32_t>(buf, s.actionCards[i]);
+        put<int32_t>(buf, s.consecutiveWins[i]);
+        put<uint8_t>(buf, s.blocked[i]);
+    }
+    for (int i = 0; i < s.numPlayers; ++i) {
+        const std::string& name = game.names[i];
+        size_t len = std::min<size_t>(name.size(), 255);
+        put<uint8_t>(buf, static_cast<uint8_t>(len));
+        buf.insert(buf.end(), name.begin(), name.begin() + static_cast<std::ptrdiff_t>(len));
+    }
+    put<uint32_t>(buf, fnv1a(buf.data(), buf.size()));
+
+    std::string tmp = path + ".tmp";
+    std::FILE* file = std::fopen(tmp.c_str(), "wb");
+    if (!file) {
+        error = "cannot create '" + tmp + "'";
+        return false;
+    }
+    bool ok = std::fwrite(buf.data(), 1, buf.size(), file) == buf.size() && std::fflush(file) == 0;
+#if defined(__unix__) || defined(__APPLE__)
+    ok = ok && fsync(fileno(file)) == 0;  // Survive a power loss, not just a crash
+#endif
+    ok = std::fclose(file) == 0 && ok;
+    if (ok && std::rename(tmp.c_str(), path.c_str()) != 0) {
+        // Platforms without atomic replace refuse to rename over a file
+        std::remove(path.c_str());
+        ok = std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+    if (!ok) {
+        std::remove(tmp.c_str());
+        error = "cannot write '" + path + "'";
+    }
+    return ok;
+}
+
+inline bool loadGame(const std::string& path, uint32_t rulesId, SavedGame& game, std::string& error) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "cannot open '" + path + "'";
+        return false;
+    }
+    std::vector<uint8_t> buf(MAX_SAVE_BYTES + 1);
+    size_t size = std::fread(buf.data(), 1, buf.size(), file);
+    std::fclose(file);
+    buf.resize(size);
+
+    error = "'" + path + "' is not a valid saved game";
+    if (size < 8 || size > MAX_SAVE_BYTES || std::memcmp(buf.data(), "SUSV", 4) != 0) return false;
+    uint32_t stored;
+    std::memcpy(&stored, buf.data() + size - 4, 4);
+    if (fnv1a(buf.data(), size - 4) != stored) {
+        error = "'" + path + "' is damaged (checksum mismatch)";
+        return false;
+    }
+    buf.resize(size - 4);
+
+    save_detail::Cursor in{buf, 4, true};
+    if (in.get<uint16_t>() != SAVE_GAME_VERSION) {
+        error = "'" + path + "' was saved by an unsupported version";
+        return false;
+    }
+    GameState s{};
+    s.numPlayers = in.get<uint8_t>();
+    s.gameOver = in.get<uint8_t>() != 0;
+    s.winner = in.get<int8_t>();
+    in.get<uint8_t>();
+    in.get<uint16_t>();
+    if (in.get<uint32_t>() != rulesId) {
+        error = "'" + path + "' was saved under a different variant or house rules";
+        return false;
+    }
+    if (s.numPlayers < MIN_PLAYERS || s.numPlayers > MAX_PLAYERS) return false;
+    if (s.winner != NO_WINNER && (s.winner < 0 || s.winner >= s.numPlayers)) return false;
+
+    uint32_t rounds = in.get<uint32_t>();
+    s.numberDeckRemaining = in.get<int32_t>();
+    s.actionDeckRemaining = in.get<int32_t>();
+    bool valid = s.numberDeckRemaining >= 0 && s.actionDeckRemaining >= 0;
+    for (int i = 0; i < s.numPlayers; ++i) {
+        s.numberCards[i] = in.get<int32_t>();
+        s.actionCards[i] = in.get<int32_t>();
+        s.consecutiveWins[i] = in.get<int32_t>();
+        s.blocked[i] = in.get<uint8_t>() != 0;
+        valid = valid && s.numberCards[i] >= 0 && s.actionCards[i] >= 0 && s.consecutiveWins[i] >= 0;
+    }
+    std::vector<std::string> names;
+    for (int i = 0; i < s.numPlayers && in.ok; ++i) {
+        size_t len = in.get<uint8_t>();
+        if (in.at + len > buf.size()) in.ok = false;
+        if (!in.ok) break;
+        names.emplace_back(reinterpret_cast<const char*>(buf.data() + in.at), len);
+        in.at += len;
+    }
+    if (!in.ok || !valid || in.at != buf.size()) return false;
+
+    game.state = s;
+    game.rounds = rounds;
+    game.names = std::move(names);
+    error.clear();
+    return true;
+}
+
+#endif // SPLIT_UNO_SAVE_GAME_H
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * SPLIT UNO - SIMULATION
+ *
+ * Plays complete games between bots through the real rule engine, and
+ * provides mergeable running statistics for summarising many games.
+ *
+ * Turn structure of a simulated game: each turn one seat (rotating from
+ * seat 0) may play an action card, then everyone plays a number round.
+ * Games that have not ended after MAX_SIMULATED_ROUNDS count as unfinished.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_SIMULATE_H
+#define SPLIT_UNO_SIMULATE_H
+
+#include <cmath>
+#include <cstdint>
+
+#include "action_table.h"
+#include "bots.h"
+#include "engine.h"
+#include "game_state.h"
+#include "round_log.h"
+#include "rules.h"
+
+constexpr uint32_t MAX_SIMULATED_ROUNDS = 2000;
+
+struct GameResult {
+    int winner;       // Winning seat, NO_WINNER if unfinished
+    uint32_t rounds;  // Number rounds played
+};
+
+// Bit (1 << ActionType) for every action the variant can play
+template <typename Rules, typename Controller>
+constexpr uint16_t playableActionMask() {
+    uint16_t mask = 0;
+    for (int t = 0; t < NUM_ACTION_TYPES; ++t) {
+        if (RuleEngine<Rules, Controller>::isPlayable(static_cast<ActionType>(t))) {
+            mask = static_cast<uint16_t>(mask | (1u << t));
+        }
+    }
+    return mask;
+}
+
+// Drives one engine until the game ends or the round cap is hit.
+template <typename Rules, typename Controller, typename... Observers>
+GameResult playEngine(RuleEngine<Rules, Controller, Observers...>& engine, Controller& bot) {
+    constexpr uint16_t playable = playableActionMask<Rules, Controller>();
+    GameState& s = engine.gameState();
+    int turn = 0;
+    while (!s.gameOver && engine.roundsPlayed() < MAX_SIMULATED_ROUNDS) {
+        int seat = turn++ % s.numPlayers;
+        ActionType action = bot.action(s, seat, playable);
+        if (action != ActionType::UNKNOWN) {
+            engine.dispatchAction(seat, action);
+            if (s.gameOver) break;
+        }
+        engine.handleNumberRound();
+    }
+    return {s.gameOver ? s.winner : NO_WINNER, engine.roundsPlayed()};
+}
+
+// Plays one game where every seat uses bot.
+template <typename Rules, typename Bot>
+GameResult playGameWith(Bot& bot, const RuleTables& tables, int numPlayers,
+                        RoundLogWriter* log = nullptr, uint32_t gameId = 0) {
+    RuleEngine<Rules, Bot> engine(tables, bot);
+    engine.newGame(numPlayers);
+    engine.attachRoundLog(log, gameId);
+    return playEngine(engine, bot);
+}
+
+// Plays one game with bot in every seat, reporting rule events to observers.
+template <typename Rules, typename Bot, typename... Observers>
+GameResult playGameObserved(Bot& bot, const RuleTables& tables, int numPlayers, RoundLogWriter* log,
+                            uint32_t gameId, Observers&... observers) {
+    RuleEngine<Rules, Bot, Observers...> engine(tables, bot, observers...);
+    engine.newGame(numPlayers);
+    engine.attachRoundLog(log, gameId);
+    return playEngine(engine, bot);
+}
+
+/*******************************************************************************
+ * STATISTICS
+ ******************************************************************************/
+
+// Streaming mean/variance (Welford); two accumulators merge exactly, so
+// worker threads keep their own and combine at the end.
+class RunningStats {
+public:
+    void add(double x) {
+        ++n;
+        double delta = x - mu;
+        mu += delta / static_cast<double>(n);
+        m2 += delta * (x - mu);
+    }
+
+    void merge(const RunningStats& o) {
+        if (o.n == 0) return;
+        if (n == 0) {
+            *this = o;
+            return;
+        }
+        double total = static_cast<double>(n + o.n);
+        double delta = o.mu - mu;
+        mu += delta * static_cast<double>(o.n) / total;
+        m2 += o.m2 + delta * delta * static_cast<double>(n) * static_cast<double>(o.n) / total;
+        n += o.n;
+    }
+
+    uint64_t count() const { return n; }
+    double mean() const { return mu; }
+    double variance() const { return n > 1 ? m2 / static_cast<double>(n - 1) : 0.0; }
+
+    // Half-width of the normal-approximation 95% confidence interval
+    double ci95() const { return n > 1 ? 1.96 * std::sqrt(variance() / static_cast<double>(n)) : 0.0; }
+
+private:
+    uint64_t n = 0;
+    double mu = 0.0;
+    double m2 = 0.0;
+};
+
+#endif // SPLIT_UNO_SIMULATE_H
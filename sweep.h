@@ -0,0 +1,393 @@
+/*******************************************************************************
+ * SPLIT UNO - RULE SWEEP
+ *
+ * Plays bot games for every point of a grid of house-rule values, spread
+ * over all cores, and reports first-player advantage and game length with
+ * 95% confidence intervals.
+ *
+ * Common random numbers: game g uses the same seed at every grid point, and
+ * one worker plays game g at all points (a chunk of games per point). Differences against
+ * the first grid point are therefore measured on paired games, so they
+ * reflect the rule change rather than dealing noise.
+ *
+ * With a precision target the sweep stops as soon as every first-player
+ * advantage (and every paired delta) is known to within that 95% half-width,
+ * instead of always playing the full game count. Workers publish running
+ * counts in their own cache lines after every game; whichever worker
+ * finishes a chunk reads them all and, once the target is met, sets a stop
+ * bit on the counter chunks are claimed from. Claims and the stop are
+ * read-modify-writes of that one counter, so every chunk claimed before the
+ * stop is played and none after it: the games played are a prefix of the
+ * full run (short games finishing first cannot bias the result), and nobody
+ * waits on anybody.
+ *
+ * The "numbers" bot (LockstepBot) never plays action cards; 2-player sweeps
+ * with it run each chunk through the lockstep kernel, many games at a time.
+ *
+ * With a round log path every worker records its games to its own file,
+ * PATH.<worker>, since a RoundLogWriter is not shared between threads. Game
+ * ids are point * games + game, so they are unique across all the files.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_SWEEP_H
+#define SPLIT_UNO_SWEEP_H
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "bot_plugin.h"
+#include "bots.h"
+#include "lockstep.h"
+#include "round_log.h"
+#include "rules.h"
+#include "simulate.h"
+
+struct SweepAxis {
+    std::string key;
+    std::vector<int> values;
+};
+
+struct SweepSettings {
+    uint64_t games = 10000;      // Games per grid point
+    int numPlayers = MIN_PLAYERS;
+    unsigned threads = 0;        // 0 = one per core
+    uint64_t seed = 1;
+    std::string bot = "greedy";  // random | greedy | numbers | plugin path
+    const BotPlugin* plugin = nullptr;  // Loaded library when bot is a plugin
+    bool events = false;         // Also report how often each rule fires
+    double precision = 0.0;      // Stop at this 95% half-width of the advantage; 0 = play all games
+    std::string record;          // Round log path prefix; empty = no log
+};
+
+inline unsigned sweepThreads(const SweepSettings& settings) {
+    return settings.threads ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Games per point before a precision target is trusted (normal approximation)
+constexpr uint64_t MIN_GAMES_BEFORE_STOP = 1000;
+
+// Parses "KEY=v1,v2;KEY=v1,..." and checks every value against the rule
+// ranges in base.
+inline bool parseSweepGrid(const std::string& spec, const RuleConfig& base, std::vector<SweepAxis>& axes,
+                           std::string& error) {
+    axes.clear();
+    std::istringstream groups(spec);
+    std::string group;
+    while (std::getline(groups, group, ';')) {
+        if (group.empty()) continue;
+        size_t eq = group.find('=');
+        if (eq == std::string::npos) {
+            error = "expected KEY=v1,v2,... in '" + group + "'";
+            return false;
+        }
+        SweepAxis axis;
+        axis.key = group.substr(0, eq);
+        for (auto& ch : axis.key) ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+
+        std::istringstream list(group.substr(eq + 1));
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            RuleConfig probe = base;
+            size_t used = 0;
+            int value = 0;
+            try {
+                value = std::stoi(item, &used);
+            } catch (...) {
+                used = 0;
+            }
+            if (used == 0 || used != item.size()) {
+                error = "'" + axis.key + "' needs integer values, got '" + item + "'";
+                return false;
+            }
+            if (!probe.set(axis.key, value, error)) return false;
+            axis.values.push_back(value);
+        }
+        if (axis.values.empty()) {
+            error = "'" + axis.key + "' has no values";
+            return false;
+        }
+        axes.push_back(axis);
+    }
+    if (axes.empty()) {
+        error = "empty sweep grid";
+        return false;
+    }
+    return true;
+}
+
+// Per-grid-point accumulators; all fields merge across workers.
+struct SweepPointStats {
+    RunningStats firstWins;      // 1 if seat 0 won (finished games)
+    RunningStats length;         // Number rounds (finished games)
+    RunningStats firstWinsDiff;  // Paired difference to grid point 0
+    RunningStats lengthDiff;     // Paired difference to grid point 0
+    uint64_t unfinished = 0;
+    RuleEventCounts events;      // Only counted with SweepSettings::events
+
+    void merge(const SweepPointStats& o) {
+        firstWins.merge(o.firstWins);
+        length.merge(o.length);
+        firstWinsDiff.merge(o.firstWinsDiff);
+        lengthDiff.merge(o.lengthDiff);
+        unfinished += o.unfinished;
+        events.merge(o.events);
+    }
+};
+
+// Counts one worker publishes for one grid point; written by that worker only
+struct alignas(64) SweepProgress {
+    std::atomic<uint64_t> finished{0};
+    std::atomic<uint64_t> firstWins{0};
+    std::atomic<uint64_t> paired{0};    // Finished here and at grid point 0
+    std::atomic<int64_t> diffSum{0};    // Sum of paired first-win differences (-1, 0, +1)
+    std::atomic<uint64_t> diffAbs{0};   // Paired games with a non-zero difference
+
+    // One finished game; diff is only counted when the game was paired
+    void record(bool firstWon, bool pairedGame, int diff) {
+        bump(finished, uint64_t{1});
+        bump(firstWins, uint64_t{firstWon});
+        if (!pairedGame) return;
+        bump(paired, uint64_t{1});
+        bump(diffSum, int64_t{diff});
+        bump(diffAbs, uint64_t{diff != 0});
+    }
+
+private:
+    // Single writer, so a plain load and store instead of a locked add
+    template <typename T>
+    static void bump(std::atomic<T>& counter, T by) {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+};
+
+// 95% half-width of a mean from its count, sum and sum of squares
+inline double halfWidth95(double n, double sum, double sumSquares) {
+    if (n < 2) return 1e9;
+    double variance = std::max(0.0, (sumSquares - sum * sum / n) / (n - 1));
+    return 1.96 * std::sqrt(variance / n);
+}
+
+// True once every advantage and delta is within the precision target
+inline bool sweepPrecisionReached(const SweepProgress* progress, unsigned threads, size_t points, double target) {
+    for (size_t p = 0; p < points; ++p) {
+        uint64_t n = 0, wins = 0, paired = 0, diffAbs = 0;
+        int64_t diffSum = 0;
+        for (unsigned t = 0; t < threads; ++t) {
+            const SweepProgress& slot = progress[t * points + p];
+            n += slot.finished.load(std::memory_order_relaxed);
+            wins += slot.firstWins.load(std::memory_order_relaxed);
+            paired += slot.paired.load(std::memory_order_relaxed);
+            diffSum += slot.diffSum.load(std::memory_order_relaxed);
+            diffAbs += slot.diffAbs.load(std::memory_order_relaxed);
+        }
+        if (n < MIN_GAMES_BEFORE_STOP) return false;
+        double w = static_cast<double>(wins);
+        if (halfWidth95(static_cast<double>(n), w, w) > target) return false;
+        if (p > 0 && halfWidth95(static_cast<double>(paired), static_cast<double>(diffSum),
+                                 static_cast<double>(diffAbs)) > target) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// logs holds one open writer per worker, or is null for no round log.
+template <typename Rules, typename Bot>
+std::vector<SweepPointStats> runSweepGames(const std::vector<RuleTables>& points, const SweepSettings& settings,
+                                           RoundLogWriter* logs) {
+    constexpr uint64_t CHUNK = 256;
+    unsigned threads = sweepThreads(settings);
+    constexpr uint64_t STOPPED = uint64_t(1) << 63;  // Set on nextGame once the precision target is met
+    std::atomic<uint64_t> nextGame{0};
+    std::vector<std::vector<SweepPointStats>> perThread(threads, std::vector<SweepPointStats>(points.size()));
+    // LockstepBot games without event counts or a round log run through the batch kernel
+    const bool lockstep =
+        std::is_same_v<Bot, LockstepBot> && settings.numPlayers == 2 && !settings.events && !logs;
+    std::unique_ptr<SweepProgress[]> progress(settings.precision > 0 ? new SweepProgress[threads * points.size()]
+                                                                     : nullptr);
+
+    auto worker = [&](unsigned id) {
+        std::vector<SweepPointStats>& local = perThread[id];
+        SweepProgress* mine = progress ? &progress[id * points.size()] : nullptr;
+        RoundLogWriter* log = logs ? &logs[id] : nullptr;
+        std::vector<uint64_t> seeds(CHUNK);
+        std::vector<GameResult> results(points.size() * CHUNK);  // Game i of the chunk at point p: p * CHUNK + i
+        while (true) {
+            uint64_t begin = nextGame.fetch_add(CHUNK);
+            if (begin >= settings.games) break;  // Also true once STOPPED is set
+            uint64_t end = std::min(settings.games, begin + CHUNK);
+            size_t count = static_cast<size_t>(end - begin);
+            for (size_t i = 0; i < count; ++i) seeds[i] = splitMix64(settings.seed ^ splitMix64(begin + i));
+            for (size_t p = 0; p < points.size(); ++p) {
+                GameResult* row = &results[p * CHUNK];
+                if (lockstep) {
+                    playLockstepGames<Rules>(points[p], LockstepPolicy::uniform(), seeds.data(), count, row);
+                    continue;
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    Bot bot = makeBot<Bot>(seeds[i], settings.plugin);
+                    uint32_t gameId = static_cast<uint32_t>(p * settings.games + begin + i);
+                    row[i] = settings.events ? playGameObserved<Rules>(bot, points[p], settings.numPlayers, log,
+                                                                       gameId, local[p].events)
+                                             : playGameWith<Rules>(bot, points[p], settings.numPlayers, log, gameId);
+                }
+            }
+            for (size_t i = 0; i < count; ++i) {
+                const GameResult& base = results[i];
+                for (size_t p = 0; p < points.size(); ++p) {
+                    const GameResult& r = results[p * CHUNK + i];
+                    SweepPointStats& st = local[p];
+                    if (r.winner == NO_WINNER) {
+                        ++st.unfinished;
+                        continue;
+                    }
+                    double first = r.winner == 0 ? 1.0 : 0.0;
+                    st.firstWins.add(first);
+                    st.length.add(r.rounds);
+                    if (base.winner != NO_WINNER) {
+                        st.firstWinsDiff.add(first - (base.winner == 0 ? 1.0 : 0.0));
+                        st.lengthDiff.add(static_cast<double>(r.rounds) - static_cast<double>(base.rounds));
+                    }
+                    if (mine) {
+                        mine[p].record(r.winner == 0, base.winner != NO_WINNER,
+                                       (r.winner == 0) - (base.winner == 0));
+                    }
+                }
+            }
+            // Every chunk claimed so far is being played; hand out no more
+            if (mine && sweepPrecisionReached(progress.get(), threads, points.size(), settings.precision)) {
+                nextGame.fetch_or(STOPPED);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    std::vector<SweepPointStats> total(points.size());
+    for (const auto& local : perThread) {
+        for (size_t p = 0; p < points.size(); ++p) total[p].merge(local[p]);
+    }
+    return total;
+}
+
+// Average occurrences of each rule outcome per game
+inline void printEventRates(std::ostream& out, const RuleEventCounts& e, uint64_t games) {
+    double g = games ? static_cast<double>(games) : 1.0;
+    auto rate = [g](uint64_t count) { return static_cast<double>(count) / g; };
+    out << std::fixed << std::setprecision(2)
+        << "  per game: " << rate(e.roundsWon) << " won rounds, " << rate(e.ties) << " ties, "
+        << rate(e.steals) << " steals (" << rate(e.cardsStolen) << " cards), " << rate(e.penalties) << " penalties\n"
+        << "            " << rate(e.blocks) << " blocks (" << rate(e.blocksCountered) << " countered), "
+        << rate(e.swaps) << " swaps, " << rate(e.colorChanges) << " color changes, " << rate(e.drawAttacks)
+        << " draw attacks (" << rate(e.drawsCountered) << " countered)\n"
+        << "            " << rate(e.truths) << " truths (" << rate(e.truthsRefused) << " refused), "
+        << rate(e.dares) << " dares (" << rate(e.daresForfeited) << " forfeited), " << rate(e.bonuses)
+        << " bonuses, " << rate(e.challenges) << " challenges\n";
+}
+
+// Plays the sweep and prints the report; false with error if the round log
+// cannot be opened (nothing is played) or written (the report still prints).
+template <typename Rules>
+bool runSweep(const RuleConfig& base, const std::vector<SweepAxis>& axes, const SweepSettings& settings,
+              std::ostream& out, std::string& error) {
+    // Expand the grid (first axis varies slowest)
+    std::vector<RuleTables> points;
+    std::vector<std::string> labels;
+    std::vector<size_t> index(axes.size(), 0);
+    while (true) {
+        RuleConfig config = base;
+        std::string label;
+        std::string ignored;
+        for (size_t a = 0; a < axes.size(); ++a) {
+            config.set(axes[a].key, axes[a].values[index[a]], ignored);
+            label += (a ? " " : "") + axes[a].key + "=" + std::to_string(axes[a].values[index[a]]);
+        }
+        points.push_back(config.tables());
+        labels.push_back(label);
+
+        size_t a = axes.size();
+        while (a > 0 && ++index[a - 1] == axes[a - 1].values.size()) index[--a] = 0;
+        if (a == 0) break;
+    }
+
+    std::unique_ptr<RoundLogWriter[]> logs;
+    if (!settings.record.empty()) {
+        if (points.size() * settings.games > UINT32_MAX) {
+            error = "too many games to record: game ids are 32-bit";
+            return false;
+        }
+        unsigned threads = sweepThreads(settings);
+        logs.reset(new RoundLogWriter[threads]);
+        for (unsigned t = 0; t < threads; ++t) {
+            if (!logs[t].open(settings.record + "." + std::to_string(t), settings.numPlayers, error)) return false;
+        }
+    }
+
+    std::vector<SweepPointStats> stats;
+    if (settings.plugin) {
+        stats = runSweepGames<Rules, PluginBot>(points, settings, logs.get());
+    } else if (settings.bot == "numbers") {
+        stats = runSweepGames<Rules, LockstepBot>(points, settings, logs.get());
+    } else if (settings.bot == "random") {
+        stats = runSweepGames<Rules, RandomBot>(points, settings, logs.get());
+    } else {
+        stats = runSweepGames<Rules, GreedyBot>(points, settings, logs.get());
+    }
+    bool written = true;
+    for (unsigned t = 0; logs && t < sweepThreads(settings); ++t) {
+        logs[t].close();
+        if (!logs[t].good()) {
+            error = "cannot write round log '" + settings.record + "." + std::to_string(t) + "'";
+            written = false;
+        }
+    }
+
+    double fair = 1.0 / settings.numPlayers;
+    out << "Rule sweep: " << Rules::NAME << " rules, " << settings.numPlayers << " players, "
+        << (settings.precision > 0 ? "up to " : "") << settings.games << " games per point, "
+        << (settings.plugin ? settings.plugin->name() : settings.bot) << " bots, seed " << settings.seed << "\n";
+    if (settings.precision > 0) {
+        uint64_t played = stats.empty() ? 0 : stats[0].firstWins.count() + stats[0].unfinished;
+        out << "Precision target +/- " << std::fixed << std::setprecision(3) << settings.precision << ": "
+            << (played < settings.games ? "reached after " + std::to_string(played) + " games"
+                                        : std::string("not reached, all games played"))
+            << "\n";
+    }
+    out << "First-player advantage = P(seat 1 wins) - " << std::fixed << std::setprecision(3) << fair
+        << "; deltas are paired against the first grid point (common random numbers).\n\n";
+    for (size_t p = 0; p < points.size(); ++p) {
+        const SweepPointStats& st = stats[p];
+        out << labels[p] << "\n" << std::fixed << std::setprecision(3)
+            << "  first-player advantage " << std::showpos << st.firstWins.mean() - fair << std::noshowpos
+            << " +/- " << st.firstWins.ci95();
+        if (p > 0) {
+            out << "   (delta " << std::showpos << st.firstWinsDiff.mean() << std::noshowpos
+                << " +/- " << st.firstWinsDiff.ci95() << ")";
+        }
+        out << "\n" << std::setprecision(1)
+            << "  game length (rounds)   " << st.length.mean() << " +/- " << st.length.ci95();
+        if (p > 0) {
+            out << "   (delta " << std::showpos << st.lengthDiff.mean() << std::noshowpos
+                << " +/- " << st.lengthDiff.ci95() << ")";
+        }
+        out << "\n  finished " << st.firstWins.count() << ", unfinished " << st.unfinished << "\n";
+        if (settings.events) printEventRates(out, st.events, st.firstWins.count() + st.unfinished);
+    }
+    return written;
+}
+
+#endif // SPLIT_UNO_SWEEP_H
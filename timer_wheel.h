@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * SPLIT UNO - TIMER WHEEL
+ *
+ * Decision deadlines for any number of concurrent games. A hierarchical
+ * timing wheel: LEVELS rings of 64 slots, where level l holds timers due
+ * between 64^l and 64^(l+1) ticks from now, in the slot of their deadline's
+ * l-th 6-bit digit. Each tick fires one level-0 slot; when level 0 wraps,
+ * the next level's current slot is emptied into the levels below it (a
+ * "cascade"), and so on up. Deadlines beyond the top level wait in an
+ * overflow list that is re-sorted once per top-level turn.
+ *
+ * Scheduling and cancelling are O(1) list operations on a node pool with a
+ * free list (no allocation once the pool has grown), and a tick costs O(1)
+ * plus the timers it fires or moves, so millions of pending deadlines cost
+ * nothing until they are due. An idle wheel skips straight to the present.
+ *
+ * Ticks are in whatever unit the host advances the wheel by (milliseconds
+ * in the arbiter).
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_TIMER_WHEEL_H
+#define SPLIT_UNO_TIMER_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct TimerId {
+    uint32_t node;
+    uint32_t generation;
+};
+
+class TimerWheel {
+public:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+
+    explicit TimerWheel(uint64_t now = 0) : current(now) { heads.fill(NONE); }
+
+    uint64_t now() const { return current; }
+    size_t size() const { return pending; }
+
+    // Fires payload at the first advance() to reach deadline; a deadline
+    // already past fires at the next advance().
+    TimerId schedule(uint64_t deadline, uint64_t payload) {
+        uint32_t n = freeHead;
+        if (n == NONE) {
+            n = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        } else {
+            freeHead = nodes[n].next;
+        }
+        Node& node = nodes[n];
+        node.deadline = deadline;
+        node.payload = payload;
+        place(n);
+        ++pending;
+        return {n, node.generation};
+    }
+
+    // Drops a timer that has not fired; false if it fired or was cancelled.
+    bool cancel(TimerId id) {
+        if (id.node >= nodes.size()) return false;
+        Node& node = nodes[id.node];
+        if (node.generation != id.generation || node.bucket == FREE) return false;
+        unlink(id.node);
+        release(id.node);
+        return true;
+    }
+
+    // Moves time forward to now, calling fire(payload) for every timer due
+    // by then, in deadline order (same-tick timers in any order). Returns
+    // the number fired.
+    template <typename Fn>
+    size_t advance(uint64_t now, Fn&& fire) {
+        size_t fired = drain(DUE, fire);
+        while (current < now) {
+            if (pending == 0) {
+                current = now;
+                break;
+            }
+            ++current;
+            if ((current & (SLOTS - 1)) == 0) {
+                cascade();
+                fired += drain(DUE, fire);  // Cascaded timers due this very tick
+            }
+            fired += drain(static_cast<uint32_t>(current & (SLOTS - 1)), fire);
+        }
+        return fired;
+    }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t OVERFLOW_BUCKET = LEVELS * SLOTS;  // Beyond the top level
+    static constexpr uint32_t DUE = OVERFLOW_BUCKET + 1;         // Scheduled in the past
+    static constexpr uint32_t FREE = DUE + 1;                    // On the free list
+
+    struct Node {
+        uint64_t deadline = 0;
+        uint64_t payload = 0;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint32_t bucket = FREE;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::array<uint32_t, DUE + 1> heads;  // List per slot, plus overflow and due
+    uint32_t freeHead = NONE;
+    uint64_t current;                     // Last tick processed
+    size_t pending = 0;
+
+    // Bucket for a node's deadline relative to the current tick
+    void place(uint32_t n) {
+        uint64_t deadline = nodes[n].deadline;
+        uint32_t bucket = DUE;
+        if (deadline > current) {
+            uint64_t delta = deadline - current;
+            bucket = OVERFLOW_BUCKET;
+            for (int level = 0; level < LEVELS; ++level) {
+                if (delta < (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+                    bucket = level * SLOTS + static_cast<uint32_t>((deadline >> (SLOT_BITS * level)) & (SLOTS - 1));
+                    break;
+                }
+            }
+        }
+        Node& node = nodes[n];
+        node.bucket = bucket;
+        node.prev = NONE;
+        node.next = heads[bucket];
+        if (node.next != NONE) nodes[node.next].prev = n;
+        heads[bucket] = n;
+    }
+
+    void unlink(uint32_t n) {
+        Node& node = nodes[n];
+        if (node.prev != NONE) {
+            nodes[node.prev].next = node.next;
+        } else {
+            heads[node.bucket] = node.next;
+        }
+        if (node.next != NONE) nodes[node.next].prev = node.prev;
+    }
+
+    void release(uint32_t n) {
+        Node& node = nodes[n];
+        node.bucket = FREE;
+        ++node.generation;
+        node.next = freeHead;
+        freeHead = n;
+        --pending;
+    }
+
+    // Re-places the timers of one bucket relative to the current tick
+    void redistribute(uint32_t bucket) {
+        uint32_t n = heads[bucket];
+        heads[bucket] = NONE;
+        while (n != NONE) {
+            uint32_t next = nodes[n].next;
+            place(n);
+            n = next;
+        }
+    }
+
+    // Level 0 has wrapped: empty the current slot of every level that wrapped
+    // with it, top-down, so their timers land in the levels below.
+    void cascade() {
+        int top = 1;
+        while (top < LEVELS && ((current >> (SLOT_BITS * top)) & (SLOTS - 1)) == 0) ++top;
+        if (top == LEVELS) redistribute(OVERFLOW_BUCKET);
+        for (int level = top < LEVELS ? top : LEVELS - 1; level >= 1; --level) {
+            redistribute(level * SLOTS + static_cast<uint32_t>((current >> (SLOT_BITS * level)) & (SLOTS - 1)));
+        }
+    }
+
+    // Fires and frees every timer of a bucket. fire may schedule or cancel.
+    template <typename Fn>
+    size_t drain(uint32_t bucket, Fn& fire) {
+        size_t fired = 0;
+        while (heads[bucket] != NONE) {
+            uint32_t n = heads[bucket];
+            uint64_t payload = nodes[n].payload;
+            unlink(n);
+            release(n);
+            fire(payload);
+            ++fired;
+        }
+        return fired;
+    }
+};
+
+#endif // SPLIT_UNO_TIMER_WHEEL_H
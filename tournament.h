@@ -0,0 +1,449 @@
+/*******************************************************************************
+ * SPLIT UNO - BOT TOURNAMENT
+ *
+ * Heads-up tournament between bot strategies, played through the real rule
+ * engine on all cores. Entrants meet in rounds, either every pair once per
+ * cycle (round robin, circle method) or Swiss style (leaders meet leaders,
+ * no rematches while avoidable). Each pairing plays a match of many games
+ * with seats alternating, and game 2k and 2k+1 share a seed so both bots
+ * get the same deal from each seat.
+ *
+ * Ratings are on the Elo scale with a Glicko rating deviation. After every
+ * round they are fitted again to all games played so far (Bradley-Terry
+ * with Glicko's starting prior, iterated to convergence), so they depend
+ * only on the results, not on the order the pairings came in, and stay
+ * independent of thread timing.
+ ******************************************************************************/
+
+#ifndef SPLIT_UNO_TOURNAMENT_H
+#define SPLIT_UNO_TOURNAMENT_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "bot_plugin.h"
+#include "bots.h"
+#include "engine.h"
+#include "rules.h"
+#include "simulate.h"
+
+// Strategies that can enter: the built-in bots in the order of
+// BUILTIN_BOT_NAMES, then plugin bots loaded from shared libraries
+using TournamentBots = std::tuple<RandomBot, GreedyBot, PluginBot>;
+constexpr size_t NUM_TOURNAMENT_BOTS = std::tuple_size_v<TournamentBots>;
+constexpr std::array<const char*, NUM_TOURNAMENT_BOTS - 1> BUILTIN_BOT_NAMES = {"random", "greedy"};
+constexpr size_t PLUGIN_BOT = NUM_TOURNAMENT_BOTS - 1;
+
+// A plugin is named by its file: anything with a '/' or ending in ".so"
+inline bool isPluginPath(const std::string& bot) {
+    return bot.find('/') != std::string::npos || (bot.size() > 3 && bot.compare(bot.size() - 3, 3, ".so") == 0);
+}
+
+enum class TournamentFormat : uint8_t { ROUND_ROBIN, SWISS };
+
+struct TournamentSettings {
+    TournamentFormat format = TournamentFormat::SWISS;
+    int rounds = 0;               // 0 = one cycle (round robin) or ceil(log2 entrants) + 1 (Swiss)
+    uint64_t gamesPerMatch = 10000;
+    unsigned threads = 0;         // 0 = one per core
+    uint64_t seed = 1;
+};
+
+struct Entrant {
+    std::string name;
+    size_t bot;                         // Index into TournamentBots
+    const BotPlugin* plugin = nullptr;  // Library of a PLUGIN_BOT entrant
+};
+
+// Parses "greedy,random,./my_bot.so", loading plugins into plugins (which
+// must outlive the entrants). Repeated entrants get numbered names.
+inline bool parseEntrants(const std::string& list, std::vector<std::unique_ptr<BotPlugin>>& plugins,
+                          std::vector<Entrant>& entrants, std::string& error) {
+    entrants.clear();
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        Entrant entrant{item, PLUGIN_BOT};
+        if (isPluginPath(item)) {
+            plugins.push_back(std::make_unique<BotPlugin>());
+            if (!plugins.back()->open(item, error)) return false;
+            entrant.name = plugins.back()->name();
+            entrant.plugin = plugins.back().get();
+        } else {
+            auto known = std::find(BUILTIN_BOT_NAMES.begin(), BUILTIN_BOT_NAMES.end(), item);
+            if (known == BUILTIN_BOT_NAMES.end()) {
+                error = "unknown bot '" + item + "'";
+                return false;
+            }
+            entrant.bot = static_cast<size_t>(known - BUILTIN_BOT_NAMES.begin());
+        }
+        int copies = 0;
+        for (const auto& e : entrants) copies += e.name == entrant.name || e.name.rfind(entrant.name + "-", 0) == 0;
+        if (copies) entrant.name += "-" + std::to_string(copies + 1);
+        entrants.push_back(entrant);
+    }
+    if (entrants.size() < 2) {
+        error = "a tournament needs at least two entrants";
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * MATCHES
+ ******************************************************************************/
+
+// Two different bots sharing one engine; bot a sits in seat aSeat.
+template <typename A, typename B>
+class MatchController : public SilentController {
+public:
+    MatchController(uint64_t seed, int aSeat, const BotPlugin* pluginA, const BotPlugin* pluginB)
+        : a(makeBot<A>(splitMix64(seed), pluginA)), b(makeBot<B>(splitMix64(~seed), pluginB)), aSeat(aSeat) {}
+
+    int bid(const GameState& s, int p) { return at(p, [&](auto& bot) { return bot.bid(s, p); }); }
+    int target(const GameState& s, int p, Prompt q) { return at(p, [&](auto& bot) { return bot.target(s, p, q); }); }
+    bool answer(const GameState& s, int p, Prompt q) { return at(p, [&](auto& bot) { return bot.answer(s, p, q); }); }
+    int choice(const GameState& s, int p, Prompt q) { return at(p, [&](auto& bot) { return bot.choice(s, p, q); }); }
+    int drawCounter(const GameState& s, int targetIdx, int amount) {
+        return at(targetIdx, [&](auto& bot) { return bot.drawCounter(s, targetIdx, amount); });
+    }
+    int challenger(const GameState& s, int winnerIdx) {
+        return at(1 - winnerIdx, [&](auto& bot) { return bot.challenger(s, winnerIdx); });
+    }
+    int challengeCard(const GameState& s, int who, int winnerIdx) {
+        return at(who, [&](auto& bot) { return bot.challengeCard(s, who, winnerIdx); });
+    }
+    ActionType action(const GameState& s, int p, uint16_t playable) {
+        return at(p, [&](auto& bot) { return bot.action(s, p, playable); });
+    }
+
+private:
+    A a;
+    B b;
+    int aSeat;
+
+    template <typename F>
+    auto at(int seat, F&& f) { return seat == aSeat ? f(a) : f(b); }
+};
+
+// Games won by each side of a match; unfinished games count as draws.
+struct MatchTally {
+    uint64_t wins[2] = {0, 0};
+    uint64_t unfinished = 0;
+
+    uint64_t games() const { return wins[0] + wins[1] + unfinished; }
+    double score(int side) const { return static_cast<double>(wins[side]) + 0.5 * static_cast<double>(unfinished); }
+};
+
+// Plays games [begin, end) of a match between bots A (side 0) and B (side 1)
+template <typename Rules, typename A, typename B>
+void playMatchGames(const RuleTables& tables, uint64_t matchSeed, uint64_t begin, uint64_t end,
+                    const BotPlugin* pluginA, const BotPlugin* pluginB, MatchTally& tally) {
+    for (uint64_t g = begin; g < end; ++g) {
+        int aSeat = static_cast<int>(g & 1);
+        MatchController<A, B> ctl(splitMix64(matchSeed ^ splitMix64(g >> 1)), aSeat, pluginA, pluginB);
+        RuleEngine<Rules, MatchController<A, B>> engine(tables, ctl);
+        engine.newGame(2);
+        GameResult r = playEngine(engine, ctl);
+        if (r.winner == NO_WINNER) {
+            ++tally.unfinished;
+        } else {
+            ++tally.wins[r.winner == aSeat ? 0 : 1];
+        }
+    }
+}
+
+namespace tournament_detail {
+
+using MatchFn = void (*)(const RuleTables&, uint64_t, uint64_t, uint64_t, const BotPlugin*, const BotPlugin*,
+                         MatchTally&);
+
+// One instantiation per ordered pair of strategies, indexed a * N + b
+template <typename Rules, size_t... I>
+constexpr std::array<MatchFn, sizeof...(I)> matchTable(std::index_sequence<I...>) {
+    return {&playMatchGames<Rules, std::tuple_element_t<I / NUM_TOURNAMENT_BOTS, TournamentBots>,
+                            std::tuple_element_t<I % NUM_TOURNAMENT_BOTS, TournamentBots>>...};
+}
+
+template <typename Rules>
+inline constexpr auto MATCHES = matchTable<Rules>(std::make_index_sequence<NUM_TOURNAMENT_BOTS * NUM_TOURNAMENT_BOTS>{});
+
+}  // namespace tournament_detail
+
+/*******************************************************************************
+ * RATINGS
+ ******************************************************************************/
+
+struct Rating {
+    double r = 1500.0;
+    double rd = 350.0;  // Rating deviation; about two of them either side is a 95% interval
+};
+
+// Head-to-head totals between every two entrants, indexed [i][j]
+struct PairResults {
+    std::vector<std::vector<double>> scored;  // Points i scored against j
+    std::vector<std::vector<double>> games;   // Games i and j played
+
+    explicit PairResults(size_t n) : scored(n, std::vector<double>(n, 0.0)), games(n, std::vector<double>(n, 0.0)) {}
+};
+
+// Most likely ratings for all results so far: Bradley-Terry on the Elo
+// scale with Glicko's starting rating as a prior, solved by Newton steps
+// per entrant (starting from the current ratings) until no rating moves.
+// Deviations come from the information in every game played, as in Glicko.
+// Bots do not change, so the same games always give the same ratings.
+inline void fitRatings(std::vector<Rating>& ratings, const PairResults& results) {
+    const double q = std::log(10.0) / 400.0;
+    const Rating prior;
+    const double priorPrecision = 1.0 / (prior.rd * prior.rd);
+    const size_t n = ratings.size();
+
+    auto expected = [&](size_t i, size_t j) { return 1.0 / (1.0 + std::exp(-q * (ratings[i].r - ratings[j].r))); };
+    auto information = [&](size_t i) {
+        double info = priorPrecision;
+        for (size_t j = 0; j < n; ++j) {
+            double e = expected(i, j);
+            info += q * q * results.games[i][j] * e * (1.0 - e);
+        }
+        return info;
+    };
+
+    for (int pass = 0; pass < 10000; ++pass) {
+        double largest = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double gain = -(ratings[i].r - prior.r) * priorPrecision;
+            for (size_t j = 0; j < n; ++j) gain += q * (results.scored[i][j] - results.games[i][j] * expected(i, j));
+            double step = std::max(-200.0, std::min(200.0, gain / information(i)));
+            ratings[i].r += step;
+            largest = std::max(largest, std::fabs(step));
+        }
+        if (largest < 1e-9) break;
+    }
+    for (size_t i = 0; i < n; ++i) ratings[i].rd = 1.0 / std::sqrt(information(i));
+}
+
+/*******************************************************************************
+ * TOURNAMENT
+ ******************************************************************************/
+
+struct EntrantStanding {
+    Rating rating;
+    double points = 0.0;  // Match points: 1 per match won, 0.5 per drawn match
+    uint64_t wins = 0, losses = 0, unfinished = 0;
+};
+
+template <typename Rules>
+class Tournament {
+public:
+    Tournament(const RuleTables& rules, std::vector<Entrant> field, const TournamentSettings& config)
+        : tables(rules), entrants(std::move(field)), settings(config), standings(entrants.size()),
+          played(entrants.size(), std::vector<bool>(entrants.size(), false)), headToHead(entrants.size()) {
+        size_t n = entrants.size();
+        int log2 = 0;
+        while ((size_t{1} << log2) < n) ++log2;
+        rounds = settings.rounds ? settings.rounds
+                                 : settings.format == TournamentFormat::SWISS ? log2 + 1 : static_cast<int>(n - (n % 2 == 0));
+    }
+
+    int totalRounds() const { return rounds; }
+    const std::vector<EntrantStanding>& results() const { return standings; }
+
+    void run(std::ostream& out) {
+        for (int round = 0; round < rounds; ++round) {
+            auto pairs = settings.format == TournamentFormat::SWISS ? swissPairs() : circlePairs(round);
+            std::vector<MatchTally> tallies = playRound(pairs, static_cast<uint64_t>(round));
+            record(pairs, tallies);
+            out << "Round " << round + 1 << "/" << rounds << ": " << pairs.size() << " matches\n";
+        }
+    }
+
+    // Entrants by rating, best first
+    std::vector<size_t> ranking() const {
+        std::vector<size_t> order(entrants.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return standings[a].rating.r > standings[b].rating.r; });
+        return order;
+    }
+
+    // With two entrants the table must rank whoever scored more head to
+    // head first; false (with a reason) if the ratings say otherwise.
+    bool checkRanking(std::string& error) const {
+        if (entrants.size() != 2) return true;
+        double first = headToHead.scored[0][1], second = headToHead.scored[1][0];
+        if (first == second) return true;
+        size_t winner = first > second ? 0 : 1;
+        if (ranking()[0] == winner) return true;
+        error = entrants[winner].name + " won the match but is not ranked first";
+        return false;
+    }
+
+    void printTable(std::ostream& out) const {
+        out << "\n" << std::left << std::setw(5) << "Rank" << std::setw(14) << "Entrant" << std::right
+            << std::setw(8) << "Rating" << std::setw(8) << "+/-" << std::setw(8) << "Points" << std::setw(10)
+            << "Won" << std::setw(10) << "Lost" << std::setw(8) << "Unfin" << std::setw(8) << "Score" << "\n";
+        int rank = 1;
+        for (size_t i : ranking()) {
+            const EntrantStanding& st = standings[i];
+            uint64_t games = st.wins + st.losses + st.unfinished;
+            double score = games ? (static_cast<double>(st.wins) + 0.5 * static_cast<double>(st.unfinished)) /
+                                       static_cast<double>(games)
+                                 : 0.0;
+            out << std::left << std::setw(5) << rank++ << std::setw(14) << entrants[i].name << std::right
+                << std::fixed << std::setprecision(0) << std::setw(8) << st.rating.r << std::setw(8)
+                << 2.0 * st.rating.rd << std::setprecision(1) << std::setw(8) << st.points << std::setw(10)
+                << st.wins << std::setw(10) << st.losses << std::setw(8) << st.unfinished << std::setw(7)
+                << 100.0 * score << "%\n";
+        }
+    }
+
+private:
+    using Pair = std::pair<size_t, size_t>;
+
+    RuleTables tables;
+    std::vector<Entrant> entrants;
+    TournamentSettings settings;
+    std::vector<EntrantStanding> standings;
+    std::vector<std::vector<bool>> played;
+    PairResults headToHead;
+    int rounds;
+
+    // Round robin by the circle method: seat 0 stays, the others rotate.
+    // An odd field gets a phantom entrant whose opponent has a bye.
+    std::vector<Pair> circlePairs(int round) const {
+        size_t n = entrants.size() + entrants.size() % 2;
+        std::vector<size_t> seats(n);
+        seats[0] = 0;
+        for (size_t i = 1; i < n; ++i) seats[i] = 1 + (i - 1 + static_cast<size_t>(round)) % (n - 1);
+        std::vector<Pair> pairs;
+        for (size_t i = 0; i < n / 2; ++i) {
+            size_t a = seats[i], b = seats[n - 1 - i];
+            if (a < entrants.size() && b < entrants.size()) pairs.emplace_back(a, b);
+        }
+        return pairs;
+    }
+
+    // Swiss: sort by match points then rating, pair each unpaired entrant
+    // with the highest one it has not met yet (or the next one if it has
+    // met everybody). An odd field gives the last entrant a bye.
+    std::vector<Pair> swissPairs() const {
+        std::vector<size_t> order(entrants.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (standings[a].points != standings[b].points) return standings[a].points > standings[b].points;
+            return standings[a].rating.r > standings[b].rating.r;
+        });
+        std::vector<bool> taken(entrants.size(), false);
+        std::vector<Pair> pairs;
+        for (size_t i = 0; i < order.size(); ++i) {
+            size_t a = order[i];
+            if (taken[a]) continue;
+            size_t pick = order.size();
+            for (size_t j = i + 1; j < order.size(); ++j) {
+                size_t b = order[j];
+                if (taken[b]) continue;
+                if (pick == order.size()) pick = j;
+                if (!played[a][b]) {
+                    pick = j;
+                    break;
+                }
+            }
+            if (pick == order.size()) break;  // Bye
+            taken[a] = taken[order[pick]] = true;
+            pairs.emplace_back(a, order[pick]);
+        }
+        return pairs;
+    }
+
+    // Splits every match into chunks of games and lets all workers pull
+    // chunks until the round is done; each chunk writes its own tally.
+    std::vector<MatchTally> playRound(const std::vector<Pair>& pairs, uint64_t round) const {
+        constexpr uint64_t CHUNK = 256;
+        uint64_t chunksPerMatch = (settings.gamesPerMatch + CHUNK - 1) / CHUNK;
+        uint64_t jobs = chunksPerMatch * pairs.size();
+        std::vector<MatchTally> chunkTallies(jobs);
+        std::atomic<uint64_t> nextJob{0};
+
+        auto worker = [&]() {
+            for (uint64_t job = nextJob.fetch_add(1); job < jobs; job = nextJob.fetch_add(1)) {
+                const Pair& pair = pairs[job / chunksPerMatch];
+                uint64_t begin = (job % chunksPerMatch) * CHUNK;
+                uint64_t end = std::min(settings.gamesPerMatch, begin + CHUNK);
+                uint64_t matchSeed = splitMix64(settings.seed ^ splitMix64(round * 1000003u + job / chunksPerMatch));
+                const Entrant& a = entrants[pair.first];
+                const Entrant& b = entrants[pair.second];
+                auto play = tournament_detail::MATCHES<Rules>[a.bot * NUM_TOURNAMENT_BOTS + b.bot];
+                play(tables, matchSeed, begin, end, a.plugin, b.plugin, chunkTallies[job]);
+            }
+        };
+
+        unsigned threads = settings.threads ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<uint64_t>(threads, std::max<uint64_t>(jobs, 1)));
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+
+        std::vector<MatchTally> tallies(pairs.size());
+        for (uint64_t job = 0; job < jobs; ++job) {
+            MatchTally& t = tallies[job / chunksPerMatch];
+            t.wins[0] += chunkTallies[job].wins[0];
+            t.wins[1] += chunkTallies[job].wins[1];
+            t.unfinished += chunkTallies[job].unfinished;
+        }
+        return tallies;
+    }
+
+    void record(const std::vector<Pair>& pairs, const std::vector<MatchTally>& tallies) {
+        for (size_t m = 0; m < pairs.size(); ++m) {
+            const MatchTally& t = tallies[m];
+            size_t side[2] = {pairs[m].first, pairs[m].second};
+            double games = static_cast<double>(t.games());
+            for (int k = 0; k < 2; ++k) {
+                EntrantStanding& st = standings[side[k]];
+                st.wins += t.wins[k];
+                st.losses += t.wins[1 - k];
+                st.unfinished += t.unfinished;
+                st.points += t.wins[k] > t.wins[1 - k] ? 1.0 : t.wins[k] == t.wins[1 - k] ? 0.5 : 0.0;
+                headToHead.scored[side[k]][side[1 - k]] += t.score(k);
+                headToHead.games[side[k]][side[1 - k]] += games;
+            }
+            played[side[0]][side[1]] = played[side[1]][side[0]] = true;
+        }
+        std::vector<Rating> ratings(entrants.size());
+        for (size_t i = 0; i < entrants.size(); ++i) ratings[i] = standings[i].rating;
+        fitRatings(ratings, headToHead);
+        for (size_t i = 0; i < entrants.size(); ++i) standings[i].rating = ratings[i];
+    }
+};
+
+// Plays the tournament and prints the table; false if the ranking check fails.
+template <typename Rules>
+bool runTournament(const RuleTables& tables, const std::vector<Entrant>& entrants, const TournamentSettings& settings,
+                   std::ostream& out) {
+    Tournament<Rules> tournament(tables, entrants, settings);
+    out << "Tournament: " << Rules::NAME << " rules, " << entrants.size() << " entrants, "
+        << (settings.format == TournamentFormat::SWISS ? "Swiss" : "round robin") << ", "
+        << tournament.totalRounds() << " rounds, " << settings.gamesPerMatch << " games per match, seed "
+        << settings.seed << "\n";
+    tournament.run(out);
+    tournament.printTable(out);
+    std::string error;
+    if (tournament.checkRanking(error)) return true;
+    out << "Ranking check failed: " << error << "\n";
+    return false;
+}
+
+#endif // SPLIT_UNO_TOURNAMENT_H